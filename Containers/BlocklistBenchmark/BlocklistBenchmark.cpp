@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "NameBlocklist.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+constexpr const char* PRANK_NAME_2 = "Amanda Hugginkiss";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// One caller in BLOCKED_INTERVAL is on the blocklist.
+constexpr size_t BLOCKED_INTERVAL = 1000;
+
+eastl::string MakeName(size_t index)
+{
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), "%s%zu %s of Springfield", FIRST_NAMES[index % 10], index, SURNAMES[(index / 10) % 10]);
+    return eastl::string(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+}
+
+template <typename Contains>
+void TimeCallers(const char* label, const eastl::vector<eastl::string>& callers, Contains contains)
+{
+    size_t blocked = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const eastl::string& caller : callers)
+    {
+        blocked += contains(eastl::string_view(caller.data(), caller.length())) ? 1 : 0;
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-44s %8.1f ms  %6.1f ns/caller  (%zu blocked)\n", label, nanoseconds / 1e6,
+        nanoseconds / static_cast<double>(callers.size()), blocked);
+}
+
+int main(int argc, char** argv)
+{
+    size_t blockedCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    size_t callerCount = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000000;
+    if (blockedCount == 0 || callerCount == 0)
+    {
+        printf("Usage: BlocklistBenchmark [blockedCount] [callerCount]\n");
+        return 1;
+    }
+
+    // Known prank names, plus every BLOCKED_INTERVAL-th generated name.
+    eastl::vector<eastl::string> blockedNames = { PRANK_NAME_1, PRANK_NAME_2 };
+    for (size_t i = 0; blockedNames.size() < blockedCount; ++i)
+    {
+        blockedNames.push_back(MakeName(i * BLOCKED_INTERVAL));
+    }
+
+    eastl::vector<eastl::string> callers;
+    callers.reserve(callerCount);
+    for (size_t i = 0; i < callerCount; ++i)
+    {
+        callers.push_back(MakeName(i));
+    }
+
+    eastl::hash_map<eastl::string, bool> hashMap;
+    StringViewMap<bool> stringViewMap;
+    NameBlocklist blocklist(blockedNames.size());
+    for (const eastl::string& name : blockedNames)
+    {
+        eastl::string_view view(name.data(), name.length());
+        hashMap.insert(eastl::make_pair(name, true));
+        stringViewMap.Insert(view, true);
+        blocklist.Add(view);
+    }
+
+    printf("%zu blocked names, %zu callers, %zu KB filter\n", blocklist.GetSize(), callers.size(), blocklist.GetFilter().GetBytes() / 1024);
+
+    TimeCallers("eastl::hash_map<eastl::string, bool>", callers, [&](eastl::string_view name)
+    {
+        return hashMap.find_as(name, eastl::hash<eastl::string_view>(), eastl::equal_to_2<eastl::string, eastl::string_view>()) != hashMap.end();
+    });
+
+    TimeCallers("StringViewMap<bool>", callers, [&](eastl::string_view name)
+    {
+        return stringViewMap.Find(name) != nullptr;
+    });
+
+    TimeCallers("BlockedBloomFilter only", callers, [&](eastl::string_view name)
+    {
+        return blocklist.GetFilter().MayContain(name);
+    });
+
+    TimeCallers("NameBlocklist (filter, then StringViewMap)", callers, [&](eastl::string_view name)
+    {
+        return blocklist.Contains(name);
+    });
+
+    return 0;
+}
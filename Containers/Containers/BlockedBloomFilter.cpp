@@ -0,0 +1,131 @@
+#include "BlockedBloomFilter.h"
+
+#include <cstdlib>
+#include <cstring>
+#include "BitUtilities.h"
+#include "StringKeyHash.h"
+
+// AVX2 tests a whole block in one instruction. Without it, SSE2 builds fall back to the shared
+// SIMD_USE_SSE2 path.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BLOOM_USE_AVX2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    // One odd multiplier per word; the top 5 bits of each product pick the word's bit.
+    alignas(32) constexpr uint32_t SALTS[BlockedBloomFilter::BLOCK_WORDS] =
+    {
+        0x47B6137BU, 0x44974D91U, 0x8824AD5BU, 0xA2B7289DU, 0x705495C7U, 0x2DF1424BU, 0x9EFC4947U, 0x5C6BFB31U
+    };
+
+    void MakeMasks(uint32_t hash, uint32_t* masks)
+    {
+        for (size_t i = 0; i < BlockedBloomFilter::BLOCK_WORDS; ++i)
+        {
+            masks[i] = 1U << ((hash * SALTS[i]) >> 27);
+        }
+    }
+}
+
+BlockedBloomFilter::BlockedBloomFilter(size_t expectedCount, size_t bitsPerKey)
+{
+    size_t bits = (expectedCount > 0 ? expectedCount : 1) * bitsPerKey;
+    mBlockCount = (bits + BLOCK_SIZE * 8 - 1) / (BLOCK_SIZE * 8);
+
+    // Blocks are aligned to a cache line so that no block straddles two.
+    size_t bytes = mBlockCount * BLOCK_SIZE;
+#if defined(_WIN32)
+    mBlocks = static_cast<uint32_t*>(_aligned_malloc(bytes, CACHE_LINE_SIZE));
+#else
+    void* allocation = nullptr;
+    mBlocks = posix_memalign(&allocation, CACHE_LINE_SIZE, bytes) == 0 ? static_cast<uint32_t*>(allocation) : nullptr;
+#endif
+
+    if (mBlocks != nullptr)
+    {
+        memset(mBlocks, 0, bytes);
+    }
+    else
+    {
+        mBlockCount = 0;
+    }
+}
+
+BlockedBloomFilter::~BlockedBloomFilter()
+{
+#if defined(_WIN32)
+    _aligned_free(mBlocks);
+#else
+    free(mBlocks);
+#endif
+}
+
+void BlockedBloomFilter::Add(eastl::string_view key)
+{
+    if (mBlockCount == 0)
+    {
+        return;
+    }
+
+    uint64_t hash = HashStringKey(key);
+    uint32_t* block = const_cast<uint32_t*>(GetBlock(hash));
+    uint32_t masks[BLOCK_WORDS];
+    MakeMasks(static_cast<uint32_t>(hash), masks);
+    for (size_t i = 0; i < BLOCK_WORDS; ++i)
+    {
+        block[i] |= masks[i];
+    }
+}
+
+bool BlockedBloomFilter::MayContain(eastl::string_view key) const
+{
+    if (mBlockCount == 0)
+    {
+        // A filter that failed to allocate passes everything through to the exact check.
+        return true;
+    }
+
+    uint64_t hash = HashStringKey(key);
+    const uint32_t* block = GetBlock(hash);
+
+#if defined(BLOOM_USE_AVX2)
+    __m256i products = _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(hash))),
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(SALTS)));
+    __m256i masks = _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_srli_epi32(products, 27));
+    // Every mask bit must be set in the block.
+    return _mm256_testc_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), masks) != 0;
+#elif defined(SIMD_USE_SSE2)
+    // SSE2 has no 32-bit multiply, so the masks are built in scalar code and tested together.
+    alignas(16) uint32_t masks[BLOCK_WORDS];
+    MakeMasks(static_cast<uint32_t>(hash), masks);
+    __m128i lowMasks = _mm_load_si128(reinterpret_cast<const __m128i*>(masks));
+    __m128i highMasks = _mm_load_si128(reinterpret_cast<const __m128i*>(masks + 4));
+    __m128i low = _mm_cmpeq_epi32(_mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), lowMasks), lowMasks);
+    __m128i high = _mm_cmpeq_epi32(_mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(block + 4)), highMasks), highMasks);
+    return _mm_movemask_epi8(_mm_and_si128(low, high)) == 0xFFFF;
+#else
+    uint32_t masks[BLOCK_WORDS];
+    MakeMasks(static_cast<uint32_t>(hash), masks);
+    for (size_t i = 0; i < BLOCK_WORDS; ++i)
+    {
+        if ((block[i] & masks[i]) != masks[i])
+        {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+const uint32_t* BlockedBloomFilter::GetBlock(uint64_t hash) const
+{
+    // Maps the high half of the hash onto [0, mBlockCount) without a division.
+    size_t index = static_cast<size_t>(((hash >> 32) * static_cast<uint64_t>(mBlockCount)) >> 32);
+    return mBlocks + index * BLOCK_WORDS;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+
+// A Bloom filter over eastl::string_view keys in which every key's bits live in one 32 byte block,
+// so a check touches a single cache line instead of one line per hash function.
+//
+// A key selects a block with the high half of its hash, then sets one bit in each of the block's
+// eight 32-bit words, chosen by multiplying the low half of the hash by a different odd constant
+// per word. A check builds the same eight masks and tests the block against all of them at once.
+// At the default 16 bits per key roughly 0.1 to 0.2% of absent keys pass the check.
+class BlockedBloomFilter
+{
+public:
+    static constexpr size_t BLOCK_WORDS = 8;
+    static constexpr size_t BLOCK_SIZE = BLOCK_WORDS * sizeof(uint32_t);
+    static constexpr size_t DEFAULT_BITS_PER_KEY = 16;
+
+    explicit BlockedBloomFilter(size_t expectedCount, size_t bitsPerKey = DEFAULT_BITS_PER_KEY);
+    ~BlockedBloomFilter();
+
+    BlockedBloomFilter(const BlockedBloomFilter&) = delete;
+    BlockedBloomFilter& operator=(const BlockedBloomFilter&) = delete;
+
+    void Add(eastl::string_view key);
+
+    // False means 'key' was never added. True means it probably was.
+    bool MayContain(eastl::string_view key) const;
+
+    size_t GetBytes() const { return mBlockCount * BLOCK_SIZE; }
+
+private:
+    const uint32_t* GetBlock(uint64_t hash) const;
+
+    uint32_t* mBlocks;
+    size_t mBlockCount;
+};
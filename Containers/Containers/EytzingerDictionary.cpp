@@ -0,0 +1,109 @@
+#include "EytzingerDictionary.h"
+
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include "BitUtilities.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+    // Nodes 8k to 8k + 7 share a cache line and are node k's descendants three levels down.
+    constexpr size_t NODES_PER_LINE = CACHE_LINE_SIZE / sizeof(uint64_t);
+
+    // The first 8 bytes of 'name' as a big-endian integer, zero padded, so that integers compare
+    // the way the prefixes do.
+    uint64_t LoadPrefix(eastl::string_view name)
+    {
+        uint64_t prefix = 0;
+        size_t length = name.length() < 8 ? name.length() : 8;
+        for (size_t i = 0; i < length; ++i)
+        {
+            prefix |= static_cast<uint64_t>(static_cast<uint8_t>(name[i])) << (56 - 8 * i);
+        }
+        return prefix;
+    }
+
+    // Prefetching may run past the last node, which is harmless, so the address is formed
+    // without pointer arithmetic.
+    void Prefetch(uintptr_t address)
+    {
+#if defined(_MSC_VER)
+        _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0);
+#else
+        __builtin_prefetch(reinterpret_cast<const void*>(address));
+#endif
+    }
+
+    // Places sorted[index...] at 'node' and its subtree with an in-order walk, which turns sorted
+    // order into Eytzinger order. Returns the next unplaced index.
+    size_t PlaceNodes(const eastl::vector<eastl::string_view>& sorted, size_t index, size_t node,
+        uint64_t* prefixes, eastl::vector<eastl::string_view>& nodes, eastl::vector<uint32_t>& nodeIds)
+    {
+        if (node < nodes.size())
+        {
+            index = PlaceNodes(sorted, index, 2 * node, prefixes, nodes, nodeIds);
+            prefixes[node] = LoadPrefix(sorted[index]);
+            nodes[node] = sorted[index];
+            nodeIds[node] = static_cast<uint32_t>(index);
+            index = PlaceNodes(sorted, index + 1, 2 * node + 1, prefixes, nodes, nodeIds);
+        }
+        return index;
+    }
+}
+
+void EytzingerDictionary::Build(const eastl::vector<eastl::string_view>& names)
+{
+    // 'names' may not point into this dictionary, since its copies are released here.
+    mNames.Clear();
+    mSortedNames.assign(names.begin(), names.end());
+    eastl::sort(mSortedNames.begin(), mSortedNames.end());
+    mSortedNames.erase(eastl::unique(mSortedNames.begin(), mSortedNames.end()), mSortedNames.end());
+    for (eastl::string_view& name : mSortedNames)
+    {
+        name = mNames.Copy(name);
+    }
+
+    size_t nodeCount = mSortedNames.size() + 1;
+    mPrefixStorage.assign(nodeCount + NODES_PER_LINE, 0);
+    size_t misalignment = reinterpret_cast<uintptr_t>(mPrefixStorage.data()) % CACHE_LINE_SIZE;
+    uint64_t* prefixes = mPrefixStorage.data() + (misalignment != 0 ? (CACHE_LINE_SIZE - misalignment) / sizeof(uint64_t) : 0);
+
+    mNodes.assign(nodeCount, eastl::string_view());
+    mNodeIds.assign(nodeCount, NOT_FOUND);
+    PlaceNodes(mSortedNames, 0, 1, prefixes, mNodes, mNodeIds);
+    mPrefixes = prefixes;
+}
+
+uint32_t EytzingerDictionary::Find(eastl::string_view name) const
+{
+    size_t node = LowerBound(name);
+    return node != 0 && mNodes[node] == name ? mNodeIds[node] : NOT_FOUND;
+}
+
+size_t EytzingerDictionary::LowerBound(eastl::string_view name) const
+{
+    if (mNodes.empty())
+    {
+        return 0;
+    }
+
+    uint64_t prefix = LoadPrefix(name);
+    size_t lastNode = mNodes.size() - 1;
+    size_t node = 1;
+    while (node <= lastNode)
+    {
+        Prefetch(reinterpret_cast<uintptr_t>(mPrefixes) + node * NODES_PER_LINE * sizeof(uint64_t));
+
+        uint64_t nodePrefix = mPrefixes[node];
+        bool less = nodePrefix < prefix || (nodePrefix == prefix && mNodes[node] < name);
+        node = 2 * node + (less ? 1 : 0);
+    }
+
+    // The search ended below the lower bound, after a left turn at it followed by right turns
+    // only. Dropping the trailing ones and that left turn gives the bound, or 0 if every node was
+    // less than 'name'.
+    return node >> (CountTrailingZeros(~static_cast<uint64_t>(node)) + 1);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "KeyArena.h"
+
+// A read-only set of names that maps each name to its position in sorted order.
+//
+// A binary search over a sorted eastl::vector<eastl::string> takes a cache miss at nearly every
+// level: the middle elements are far apart, and each comparison follows a pointer to the string's
+// characters. This dictionary stores the names in Eytzinger order instead, the order of a breadth
+// first walk of the implicit search tree. Node k's children are nodes 2k and 2k + 1, so the nodes
+// a search will visit a few levels down sit next to each other and are prefetched while the
+// current level is compared.
+//
+// Every node also caches the name's first 8 bytes as a big-endian integer. Comparing those orders
+// most names with a single integer compare, and the search only reads the name itself when the
+// prefixes tie. The descent has no data-dependent branches apart from that tie.
+class EytzingerDictionary
+{
+public:
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFF;
+
+    EytzingerDictionary() = default;
+
+    EytzingerDictionary(const EytzingerDictionary&) = delete;
+    EytzingerDictionary& operator=(const EytzingerDictionary&) = delete;
+
+    // Replaces the contents with a sorted, deduplicated copy of 'names'.
+    void Build(const eastl::vector<eastl::string_view>& names);
+
+    // The id of 'name', which is its position in sorted order, or NOT_FOUND.
+    uint32_t Find(eastl::string_view name) const;
+
+    eastl::string_view GetName(uint32_t id) const { return mSortedNames[id]; }
+    size_t GetSize() const { return mSortedNames.size(); }
+
+private:
+    // Nodes are numbered from 1, so 0 is never a valid node.
+    size_t LowerBound(eastl::string_view name) const;
+
+    // Points into mPrefixStorage so that node 8k starts a cache line.
+    const uint64_t* mPrefixes = nullptr;
+    eastl::vector<uint64_t> mPrefixStorage;
+    eastl::vector<eastl::string_view> mNodes;
+    eastl::vector<uint32_t> mNodeIds;
+
+    eastl::vector<eastl::string_view> mSortedNames;
+    KeyArena mNames;
+};
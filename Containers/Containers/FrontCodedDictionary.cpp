@@ -0,0 +1,190 @@
+#include "FrontCodedDictionary.h"
+
+#include <cstring>
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include "EncodingUtilities.h"
+
+namespace
+{
+    size_t SharedPrefixLength(eastl::string_view a, eastl::string_view b)
+    {
+        size_t length = a.length() < b.length() ? a.length() : b.length();
+        size_t shared = 0;
+        while (shared < length && a[shared] == b[shared])
+        {
+            ++shared;
+        }
+        return shared;
+    }
+}
+
+bool FrontCodedDictionary::Iterator::Next(eastl::string_view& name)
+{
+    if (mId >= mDictionary.mCount)
+    {
+        return false;
+    }
+
+    // Buckets are stored back to back, so reading on from the end of one bucket reaches the next head.
+    const char* data = mDictionary.mData.data();
+    if (mId % BUCKET_SIZE == 0)
+    {
+        size_t length = ReadVarint(data, mOffset);
+        mName.assign(data + mOffset, length);
+        mOffset += length;
+    }
+    else
+    {
+        size_t shared = ReadVarint(data, mOffset);
+        size_t suffixLength = ReadVarint(data, mOffset);
+        mName.resize(shared);
+        mName.append(data + mOffset, suffixLength);
+        mOffset += suffixLength;
+    }
+
+    ++mId;
+    name = eastl::string_view(mName.data(), mName.length());
+    return true;
+}
+
+void FrontCodedDictionary::Build(const eastl::vector<eastl::string_view>& names)
+{
+    eastl::vector<eastl::string_view> sorted(names.begin(), names.end());
+    eastl::sort(sorted.begin(), sorted.end());
+    sorted.erase(eastl::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    mData.clear();
+    mBucketOffsets.clear();
+    mCount = sorted.size();
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        eastl::string_view name = sorted[i];
+        if (i % BUCKET_SIZE == 0)
+        {
+            mBucketOffsets.push_back(mData.size());
+            WriteVarint(mData, name.length());
+            mData.insert(mData.end(), name.data(), name.data() + name.length());
+        }
+        else
+        {
+            size_t shared = SharedPrefixLength(sorted[i - 1], name);
+            WriteVarint(mData, shared);
+            WriteVarint(mData, name.length() - shared);
+            mData.insert(mData.end(), name.data() + shared, name.data() + name.length());
+        }
+    }
+
+    mData.shrink_to_fit();
+    mBucketOffsets.shrink_to_fit();
+}
+
+uint32_t FrontCodedDictionary::Find(eastl::string_view name) const
+{
+    // The last bucket whose head is not greater than 'name'.
+    size_t low = 0;
+    size_t high = mBucketOffsets.size();
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        size_t offset;
+        if (GetBucketHead(middle, offset) <= name)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (low == 0)
+    {
+        return NOT_FOUND;
+    }
+
+    size_t bucket = low - 1;
+    size_t offset;
+    eastl::string_view head = GetBucketHead(bucket, offset);
+    size_t id = bucket * BUCKET_SIZE;
+    if (head == name)
+    {
+        return static_cast<uint32_t>(id);
+    }
+
+    // Every name scanned so far is less than 'name'. 'matched' is how much of 'name' the last of
+    // them shares, which is all that is needed to place the next name without decoding it.
+    const char* data = mData.data();
+    size_t matched = SharedPrefixLength(head, name);
+    size_t end = id + BUCKET_SIZE < mCount ? id + BUCKET_SIZE : mCount;
+    for (++id; id < end; ++id)
+    {
+        size_t shared = ReadVarint(data, offset);
+        size_t suffixLength = ReadVarint(data, offset);
+        const char* suffix = data + offset;
+        offset += suffixLength;
+
+        if (shared > matched)
+        {
+            // Agrees with the previous name where it fell below 'name', so it is below too.
+            continue;
+        }
+        if (shared < matched)
+        {
+            // Rises above the previous name where that one still agreed with 'name'.
+            return NOT_FOUND;
+        }
+
+        size_t i = 0;
+        while (i < suffixLength && matched + i < name.length() && suffix[i] == name[matched + i])
+        {
+            ++i;
+        }
+        if (matched + i == name.length())
+        {
+            return i == suffixLength ? static_cast<uint32_t>(id) : NOT_FOUND;
+        }
+        if (i < suffixLength && static_cast<uint8_t>(suffix[i]) > static_cast<uint8_t>(name[matched + i]))
+        {
+            return NOT_FOUND;
+        }
+        matched += i;
+    }
+    return NOT_FOUND;
+}
+
+size_t FrontCodedDictionary::Decode(uint32_t id, char* buffer, size_t capacity) const
+{
+    if (id >= mCount)
+    {
+        return 0;
+    }
+
+    // Each name is rebuilt over the one before it; a byte of the final name may have been written
+    // by any earlier name in the bucket.
+    size_t bucket = id / BUCKET_SIZE;
+    size_t offset;
+    eastl::string_view head = GetBucketHead(bucket, offset);
+    CopyClamped(buffer, capacity, 0, head.data(), head.length());
+    size_t length = head.length();
+
+    const char* data = mData.data();
+    for (size_t i = bucket * BUCKET_SIZE + 1; i <= id; ++i)
+    {
+        size_t shared = ReadVarint(data, offset);
+        size_t suffixLength = ReadVarint(data, offset);
+        CopyClamped(buffer, capacity, shared, data + offset, suffixLength);
+        offset += suffixLength;
+        length = shared + suffixLength;
+    }
+    return length;
+}
+
+eastl::string_view FrontCodedDictionary::GetBucketHead(size_t bucket, size_t& offset) const
+{
+    offset = static_cast<size_t>(mBucketOffsets[bucket]);
+    size_t length = ReadVarint(mData.data(), offset);
+    eastl::string_view head(mData.data() + offset, length);
+    offset += length;
+    return head;
+}
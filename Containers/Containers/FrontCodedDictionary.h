@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+// A read-only sorted set of names stored with front coding, for name lists too large to keep as
+// separate strings.
+//
+// Sorted names tend to repeat most of the name before them. The names are split into buckets of
+// BUCKET_SIZE. The first name of each bucket, its head, is stored in full; every other name is
+// stored as the length of the prefix it shares with the previous name followed by the rest of it.
+// Lengths are varints, so a name that differs from its neighbour in the last few characters costs
+// a few bytes.
+//
+// Find() binary searches the bucket heads, which can be compared in place, then scans a single
+// bucket without decoding into a buffer. Names are decoded on demand with Decode(), or in order
+// with an Iterator. Ids are positions in sorted order.
+class FrontCodedDictionary
+{
+public:
+    static constexpr size_t BUCKET_SIZE = 16;
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFF;
+
+    // Reads the names in sorted order, decoding each one into a buffer it owns. The view returned
+    // by Next() is valid until the following call.
+    class Iterator
+    {
+    public:
+        explicit Iterator(const FrontCodedDictionary& dictionary) : mDictionary(dictionary) {}
+
+        // Returns false after the last name.
+        bool Next(eastl::string_view& name);
+
+    private:
+        const FrontCodedDictionary& mDictionary;
+        eastl::string mName;
+        size_t mOffset = 0;
+        uint32_t mId = 0;
+    };
+
+    // Replaces the contents with a sorted, deduplicated copy of 'names'.
+    void Build(const eastl::vector<eastl::string_view>& names);
+
+    // The id of 'name', or NOT_FOUND.
+    uint32_t Find(eastl::string_view name) const;
+
+    // Writes up to 'capacity' bytes of the name with 'id' to 'buffer' and returns its full length.
+    // The name is complete only if the length returned is no greater than 'capacity'.
+    size_t Decode(uint32_t id, char* buffer, size_t capacity) const;
+
+    size_t GetSize() const { return mCount; }
+    // Bytes used by the encoded names and the bucket index.
+    size_t GetEncodedBytes() const { return mData.size() + mBucketOffsets.size() * sizeof(uint64_t); }
+
+private:
+    eastl::string_view GetBucketHead(size_t bucket, size_t& offset) const;
+
+    eastl::vector<char> mData;
+    // Where each bucket's head starts in mData.
+    eastl::vector<uint64_t> mBucketOffsets;
+    size_t mCount = 0;
+};
@@ -0,0 +1,51 @@
+#include "KeyArena.h"
+
+#include <cstring>
+
+KeyArena::~KeyArena()
+{
+    Clear();
+}
+
+eastl::string_view KeyArena::Copy(eastl::string_view key)
+{
+    char* storage = nullptr;
+    if (key.length() > CHUNK_SIZE)
+    {
+        // The current chunk stays open for the keys that follow.
+        storage = new char[key.length()];
+        mChunks.push_back(storage);
+        mReservedBytes += key.length();
+    }
+    else
+    {
+        if (static_cast<size_t>(mEnd - mCursor) < key.length() || mCursor == nullptr)
+        {
+            mCursor = new char[CHUNK_SIZE];
+            mEnd = mCursor + CHUNK_SIZE;
+            mChunks.push_back(mCursor);
+            mReservedBytes += CHUNK_SIZE;
+        }
+
+        storage = mCursor;
+        mCursor += key.length();
+    }
+
+    if (key.length() > 0)
+    {
+        memcpy(storage, key.data(), key.length());
+    }
+    return eastl::string_view(storage, key.length());
+}
+
+void KeyArena::Clear()
+{
+    for (char* chunk : mChunks)
+    {
+        delete[] chunk;
+    }
+    mChunks.clear();
+    mCursor = nullptr;
+    mEnd = nullptr;
+    mReservedBytes = 0;
+}
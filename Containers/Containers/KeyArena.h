@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+// Owns copies of container keys, packed end to end into 64KB chunks. Copies never move, so a
+// container can hold eastl::string_views into the arena instead of an eastl::string per entry, and
+// can rehash without touching key bytes. Nothing is freed until Clear() or destruction.
+class KeyArena
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    KeyArena() = default;
+    ~KeyArena();
+
+    KeyArena(const KeyArena&) = delete;
+    KeyArena& operator=(const KeyArena&) = delete;
+
+    // Keys longer than a chunk get an allocation of their own.
+    eastl::string_view Copy(eastl::string_view key);
+
+    // Invalidates every copy.
+    void Clear();
+
+    size_t GetReservedBytes() const { return mReservedBytes; }
+
+private:
+    eastl::vector<char*> mChunks;
+    char* mCursor = nullptr;
+    char* mEnd = nullptr;
+    size_t mReservedBytes = 0;
+};
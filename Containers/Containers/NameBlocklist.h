@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <EASTL/string.h>
+#include "BlockedBloomFilter.h"
+#include "StringViewMap.h"
+
+// An exact set of blocked names with a BlockedBloomFilter in front of it. Almost every name
+// checked is not on the list, and for those the filter's single cache line answers without
+// probing the map. The few names that pass the filter are confirmed by an exact lookup.
+class NameBlocklist
+{
+public:
+    explicit NameBlocklist(size_t expectedCount) : mFilter(expectedCount)
+    {
+        mNames.Reserve(expectedCount);
+    }
+
+    void Add(eastl::string_view name)
+    {
+        if (mNames.Insert(name, true))
+        {
+            mFilter.Add(name);
+        }
+    }
+
+    bool Contains(eastl::string_view name) const
+    {
+        return mFilter.MayContain(name) && mNames.Find(name) != nullptr;
+    }
+
+    size_t GetSize() const { return mNames.GetSize(); }
+    const BlockedBloomFilter& GetFilter() const { return mFilter; }
+
+private:
+    BlockedBloomFilter mFilter;
+    StringViewMap<bool> mNames;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <EASTL/string.h>
+
+// A 64-bit hash for container keys that consumes 8 bytes per step and finishes with a full
+// avalanche, so that both the low bits and the high bits are usable on their own. eastl::hash
+// walks one byte at a time and its high bits are poor for short keys.
+inline uint64_t HashStringKey(eastl::string_view key)
+{
+    constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+    const char* data = key.data();
+    size_t length = key.length();
+    uint64_t hash = length * MULTIPLIER;
+
+    size_t offset = 0;
+    for (; offset + 8 <= length; offset += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + offset, 8);
+        hash = (hash ^ word) * MULTIPLIER;
+        hash ^= hash >> 29;
+    }
+
+    if (offset < length)
+    {
+        uint64_t word = 0;
+        memcpy(&word, data + offset, length - offset);
+        hash = (hash ^ word) * MULTIPLIER;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <EASTL/string.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+#include "BitUtilities.h"
+#include "KeyArena.h"
+#include "StringKeyHash.h"
+
+// Slots are probed in groups of 16. Each slot has a control byte: EMPTY, DELETED, or the low 7
+// bits of the key's hash when the slot is full.
+constexpr size_t CONTROL_GROUP_SIZE = 16;
+constexpr int8_t CONTROL_EMPTY = -128;
+constexpr int8_t CONTROL_DELETED = -2;
+
+// Bit i is set if control byte i of the group equals 'tag'.
+inline uint32_t ControlMatchTag(const int8_t* group, int8_t tag)
+{
+#if defined(SIMD_USE_SSE2)
+    __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(tag))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < CONTROL_GROUP_SIZE; ++i)
+    {
+        mask |= static_cast<uint32_t>(group[i] == tag) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i is set if slot i of the group is EMPTY or DELETED, the only control bytes with the high bit set.
+inline uint32_t ControlMatchAvailable(const int8_t* group)
+{
+#if defined(SIMD_USE_SSE2)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < CONTROL_GROUP_SIZE; ++i)
+    {
+        mask |= static_cast<uint32_t>(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+inline uint32_t ControlMatchEmpty(const int8_t* group)
+{
+    return ControlMatchTag(group, CONTROL_EMPTY);
+}
+
+// An open addressing hash map from eastl::string_view to V, laid out like a Swiss table.
+//
+// A lookup hashes the key once, then scans 16 control bytes at a time with one vector compare
+// against the key's 7-bit tag. Only slots whose tag matches are visited, and each slot keeps the
+// key's full hash, so a tag collision is almost always rejected without touching the key's bytes.
+// A group with an EMPTY slot ends the probe.
+//
+// Keys are copied into the map's KeyArena, so entries hold a pointer and a length rather than an
+// eastl::string. Erased keys keep their bytes until Clear(). Pointers to values are invalidated by
+// any insert that grows the table.
+template <typename V>
+class StringViewMap
+{
+public:
+    StringViewMap() = default;
+    ~StringViewMap() { Release(); }
+
+    StringViewMap(const StringViewMap&) = delete;
+    StringViewMap& operator=(const StringViewMap&) = delete;
+
+    // Returns false, leaving the existing value in place, if 'key' is already present. Keys must be
+    // shorter than 4GB.
+    bool Insert(eastl::string_view key, V value)
+    {
+        uint64_t hash = HashStringKey(key);
+        if (FindSlot(key, hash) != nullptr)
+        {
+            return false;
+        }
+
+        if (mGrowthLeft == 0)
+        {
+            // Tombstones are cleared by rehashing at the same size when they make up the load.
+            Rehash(mSize * 2 < GetCapacity() ? mGroupCount : (mGroupCount != 0 ? mGroupCount * 2 : 1));
+        }
+
+        size_t index = FindAvailable(hash);
+        if (mControl[index] == CONTROL_EMPTY)
+        {
+            --mGrowthLeft;
+        }
+
+        eastl::string_view copy = mKeys.Copy(key);
+        Slot& slot = mSlots[index];
+        slot.hash = hash;
+        slot.keyData = copy.data();
+        slot.keyLength = static_cast<uint32_t>(copy.length());
+        new (&slot.value) V(eastl::move(value));
+        mControl[index] = static_cast<int8_t>(hash & 0x7F);
+        ++mSize;
+        return true;
+    }
+
+    V* Find(eastl::string_view key)
+    {
+        Slot* slot = FindSlot(key, HashStringKey(key));
+        return slot != nullptr ? &slot->value : nullptr;
+    }
+
+    const V* Find(eastl::string_view key) const
+    {
+        const Slot* slot = FindSlot(key, HashStringKey(key));
+        return slot != nullptr ? &slot->value : nullptr;
+    }
+
+    bool Erase(eastl::string_view key)
+    {
+        Slot* slot = FindSlot(key, HashStringKey(key));
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        size_t index = static_cast<size_t>(slot - mSlots);
+        slot->value.~V();
+        --mSize;
+
+        // A probe only continues past a group that has no EMPTY slot. If this group already has
+        // one, no probe can be passing through it and the slot can be reused freely.
+        const int8_t* group = mControl + index / CONTROL_GROUP_SIZE * CONTROL_GROUP_SIZE;
+        if (ControlMatchEmpty(group) != 0)
+        {
+            mControl[index] = CONTROL_EMPTY;
+            ++mGrowthLeft;
+        }
+        else
+        {
+            mControl[index] = CONTROL_DELETED;
+        }
+        return true;
+    }
+
+    // Sizes the table so that 'count' keys fit without rehashing.
+    void Reserve(size_t count)
+    {
+        size_t groupCount = mGroupCount != 0 ? mGroupCount : 1;
+        while (groupCount * CONTROL_GROUP_SIZE * 7 / 8 < count)
+        {
+            groupCount *= 2;
+        }
+        if (groupCount != mGroupCount)
+        {
+            Rehash(groupCount);
+        }
+    }
+
+    void Clear()
+    {
+        Release();
+        mKeys.Clear();
+    }
+
+    size_t GetSize() const { return mSize; }
+    size_t GetCapacity() const { return mGroupCount * CONTROL_GROUP_SIZE; }
+    size_t GetKeyBytes() const { return mKeys.GetReservedBytes(); }
+
+private:
+    struct Slot
+    {
+        uint64_t hash;
+        const char* keyData;
+        // Keeps a slot with a small value at 24 bytes.
+        uint32_t keyLength;
+        V value;
+    };
+
+    Slot* FindSlot(eastl::string_view key, uint64_t hash) const
+    {
+        if (mGroupCount == 0)
+        {
+            return nullptr;
+        }
+
+        int8_t tag = static_cast<int8_t>(hash & 0x7F);
+        size_t groupMask = mGroupCount - 1;
+        size_t group = (hash >> 7) & groupMask;
+
+        // Triangular steps visit every group once when the group count is a power of two.
+        for (size_t probe = 1; probe <= mGroupCount; ++probe)
+        {
+            const int8_t* control = mControl + group * CONTROL_GROUP_SIZE;
+            for (uint32_t match = ControlMatchTag(control, tag); match != 0; match &= match - 1)
+            {
+                Slot& slot = mSlots[group * CONTROL_GROUP_SIZE + CountTrailingZeros(match)];
+                if (slot.hash == hash && slot.keyLength == key.length() &&
+                    (key.length() == 0 || memcmp(slot.keyData, key.data(), key.length()) == 0))
+                {
+                    return &slot;
+                }
+            }
+
+            if (ControlMatchEmpty(control) != 0)
+            {
+                return nullptr;
+            }
+            group = (group + probe) & groupMask;
+        }
+        return nullptr;
+    }
+
+    // The first EMPTY or DELETED slot on the probe sequence for 'hash'. The table must not be full.
+    size_t FindAvailable(uint64_t hash) const
+    {
+        size_t groupMask = mGroupCount - 1;
+        size_t group = (hash >> 7) & groupMask;
+        for (size_t probe = 1; ; ++probe)
+        {
+            uint32_t available = ControlMatchAvailable(mControl + group * CONTROL_GROUP_SIZE);
+            if (available != 0)
+            {
+                return group * CONTROL_GROUP_SIZE + CountTrailingZeros(available);
+            }
+            group = (group + probe) & groupMask;
+        }
+    }
+
+    void Rehash(size_t groupCount)
+    {
+        int8_t* oldControl = mControl;
+        Slot* oldSlots = mSlots;
+        size_t oldCapacity = GetCapacity();
+
+        size_t capacity = groupCount * CONTROL_GROUP_SIZE;
+        mControl = new int8_t[capacity];
+        memset(mControl, CONTROL_EMPTY, capacity);
+        mSlots = static_cast<Slot*>(::operator new(capacity * sizeof(Slot)));
+        mGroupCount = groupCount;
+        mGrowthLeft = capacity * 7 / 8 - mSize;
+
+        // Keys stay in the arena; only the slots move.
+        for (size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldControl[i] >= 0)
+            {
+                Slot& from = oldSlots[i];
+                size_t index = FindAvailable(from.hash);
+                Slot& to = mSlots[index];
+                to.hash = from.hash;
+                to.keyData = from.keyData;
+                to.keyLength = from.keyLength;
+                new (&to.value) V(eastl::move(from.value));
+                from.value.~V();
+                mControl[index] = oldControl[i];
+            }
+        }
+
+        delete[] oldControl;
+        ::operator delete(oldSlots);
+    }
+
+    void Release()
+    {
+        if (!eastl::is_trivially_destructible<V>::value)
+        {
+            for (size_t i = 0; i < GetCapacity(); ++i)
+            {
+                if (mControl[i] >= 0)
+                {
+                    mSlots[i].value.~V();
+                }
+            }
+        }
+
+        delete[] mControl;
+        ::operator delete(mSlots);
+        mControl = nullptr;
+        mSlots = nullptr;
+        mGroupCount = 0;
+        mSize = 0;
+        mGrowthLeft = 0;
+    }
+
+    int8_t* mControl = nullptr;
+    Slot* mSlots = nullptr;
+    size_t mGroupCount = 0;
+    size_t mSize = 0;
+    // Slots that can still become full before the table is over 7/8 loaded. DELETED slots count
+    // against it until a rehash.
+    size_t mGrowthLeft = 0;
+    KeyArena mKeys;
+};
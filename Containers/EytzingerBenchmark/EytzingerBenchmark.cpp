@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "EytzingerDictionary.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+uint64_t NextRandom(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+eastl::vector<eastl::string> MakeNames(size_t nameCount, const char* town)
+{
+    eastl::vector<eastl::string> names;
+    names.reserve(nameCount);
+    char buffer[64];
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%s%zu %s of %s", FIRST_NAMES[i % 10], i, SURNAMES[(i / 10) % 10], town);
+        names.push_back(buffer);
+    }
+    return names;
+}
+
+// Looks up names picked at random and sums the ids found, so that the lookups cannot be
+// optimised away. Misses add nothing.
+template <typename Lookup>
+void TimeLookups(const char* label, const eastl::vector<eastl::string>& queries, size_t lookupCount, Lookup lookup)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookupCount; ++i)
+    {
+        const eastl::string& query = queries[NextRandom(state) % queries.size()];
+        checksum += lookup(eastl::string_view(query.data(), query.length()));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+    printf("  %-10s %8.1f ms  %6.1f ns/lookup  (checksum %llu)\n", label, nanoseconds / 1e6,
+        nanoseconds / static_cast<double>(lookupCount), static_cast<unsigned long long>(checksum));
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t lookupCount = argc > 2 ? strtoull(argv[2], nullptr, 10) : 10000000;
+    if (nameCount == 0 || lookupCount == 0)
+    {
+        printf("Usage: EytzingerBenchmark [nameCount] [lookupCount]\n");
+        return 1;
+    }
+
+    eastl::vector<eastl::string> names = MakeNames(nameCount, "Springfield");
+    eastl::vector<eastl::string> misses = MakeNames(nameCount, "Shelbyville");
+    printf("%zu names, %zu random lookups\n", nameCount, lookupCount);
+
+    // Binary search over sorted strings; the id is the position in sorted order.
+    eastl::vector<eastl::string> sorted = names;
+    eastl::sort(sorted.begin(), sorted.end());
+    auto binarySearch = [&](eastl::string_view name) -> uint64_t
+    {
+        auto it = eastl::lower_bound(sorted.begin(), sorted.end(), name,
+            [](const eastl::string& element, eastl::string_view value)
+            {
+                return eastl::string_view(element.data(), element.length()) < value;
+            });
+        return it != sorted.end() && eastl::string_view(it->data(), it->length()) == name ? static_cast<uint64_t>(it - sorted.begin()) : 0;
+    };
+
+    printf("eastl::lower_bound over sorted eastl::vector<eastl::string>\n");
+    TimeLookups("hits", names, lookupCount, binarySearch);
+    TimeLookups("misses", misses, lookupCount, binarySearch);
+
+    eastl::vector<eastl::string_view> views;
+    views.reserve(names.size());
+    for (const eastl::string& name : names)
+    {
+        views.push_back(eastl::string_view(name.data(), name.length()));
+    }
+
+    EytzingerDictionary dictionary;
+    auto start = std::chrono::steady_clock::now();
+    dictionary.Build(views);
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto eytzingerSearch = [&](eastl::string_view name) -> uint64_t
+    {
+        uint32_t id = dictionary.Find(name);
+        return id != EytzingerDictionary::NOT_FOUND ? id : 0;
+    };
+
+    printf("EytzingerDictionary\n");
+    printf("  %-10s %8.1f ms\n", "build", milliseconds);
+    TimeLookups("hits", names, lookupCount, eytzingerSearch);
+    TimeLookups("misses", misses, lookupCount, eytzingerSearch);
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/sort.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "FootprintReport.h"
+#include "FrontCodedDictionary.h"
+#include "KeyArena.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	RecordEastlAllocation(size);
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	RecordEastlAllocation(size);
+	return new uint8_t[size];
+}
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+uint64_t NextRandom(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// Sorted neighbours share everything up to the last few digits, like a real sorted corpus.
+size_t MakeName(size_t index, char* buffer, size_t capacity)
+{
+    int length = snprintf(buffer, capacity, "%s %s of Springfield #%09zu", FIRST_NAMES[(index / 10) % 10], SURNAMES[index % 10], index);
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+void PrintBytes(const char* label, size_t bytes, size_t nameCount)
+{
+    printf("%-44s %10zu KB  %6.1f bytes/name\n", label, bytes / 1024, static_cast<double>(bytes) / static_cast<double>(nameCount));
+}
+
+void PrintTime(const char* label, std::chrono::steady_clock::time_point start, size_t operations, uint64_t checksum)
+{
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("%-44s %8.1f ms  %6.1f ns/op  (checksum %llu)\n", label, nanoseconds / 1e6,
+        nanoseconds / static_cast<double>(operations), static_cast<unsigned long long>(checksum));
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+    size_t lookupCount = argc > 2 ? strtoull(argv[2], nullptr, 10) : 2000000;
+    if (nameCount == 0 || lookupCount == 0)
+    {
+        printf("Usage: FrontCodingBenchmark [nameCount] [lookupCount]\n");
+        return 1;
+    }
+
+    // One eastl::string per name. The EASTL hooks count the vector and every heap buffer.
+    uint64_t before = TakeFootprintSample().eastlHeapBytes;
+    eastl::vector<eastl::string> strings;
+    strings.reserve(nameCount);
+    size_t nameBytes = 0;
+    char buffer[128];
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        size_t length = MakeName(i, buffer, sizeof(buffer));
+        strings.push_back(eastl::string(buffer, length));
+        nameBytes += length;
+    }
+    uint64_t stringBytes = TakeFootprintSample().eastlHeapBytes - before;
+    eastl::sort(strings.begin(), strings.end());
+
+    // Names packed end to end, each referenced by a view.
+    KeyArena pool;
+    eastl::vector<eastl::string_view> views;
+    views.reserve(nameCount);
+    for (const eastl::string& name : strings)
+    {
+        views.push_back(pool.Copy(eastl::string_view(name.data(), name.length())));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    FrontCodedDictionary dictionary;
+    dictionary.Build(views);
+    double buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%zu names, %zu lookups\n", nameCount, lookupCount);
+    PrintBytes("name characters", nameBytes, nameCount);
+    PrintBytes("eastl::vector<eastl::string>", static_cast<size_t>(stringBytes), nameCount);
+    PrintBytes("eastl::string_view + packed pool", pool.GetReservedBytes() + views.capacity() * sizeof(eastl::string_view), nameCount);
+    PrintBytes("FrontCodedDictionary", dictionary.GetEncodedBytes(), nameCount);
+    printf("%-44s %8.1f ms\n", "FrontCodedDictionary build", buildMilliseconds);
+
+    // Sequential decoding, the access pattern front coding is best at.
+    start = std::chrono::steady_clock::now();
+    uint64_t checksum = 0;
+    FrontCodedDictionary::Iterator iterator(dictionary);
+    eastl::string_view name;
+    while (iterator.Next(name))
+    {
+        checksum += name.length();
+    }
+    PrintTime("Iterator over every name", start, dictionary.GetSize(), checksum);
+
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    start = std::chrono::steady_clock::now();
+    checksum = 0;
+    for (size_t i = 0; i < lookupCount; ++i)
+    {
+        checksum += dictionary.Decode(static_cast<uint32_t>(NextRandom(state) % dictionary.GetSize()), buffer, sizeof(buffer));
+    }
+    PrintTime("Decode() of random ids", start, lookupCount, checksum);
+
+    state = 0x9E3779B97F4A7C15ull;
+    start = std::chrono::steady_clock::now();
+    checksum = 0;
+    for (size_t i = 0; i < lookupCount; ++i)
+    {
+        checksum += dictionary.Find(views[NextRandom(state) % views.size()]);
+    }
+    PrintTime("Find() of random names", start, lookupCount, checksum);
+
+    return 0;
+}
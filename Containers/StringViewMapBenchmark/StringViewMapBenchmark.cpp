@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "StringViewMap.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// Each name is routed to one of this many templates.
+constexpr uint32_t TEMPLATE_COUNT = 8;
+
+uint64_t NextRandom(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+eastl::vector<eastl::string> MakeNames(size_t nameCount, const char* town)
+{
+    eastl::vector<eastl::string> names;
+    names.reserve(nameCount);
+    char buffer[64];
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%s%zu %s of %s", FIRST_NAMES[i % 10], i, SURNAMES[(i / 10) % 10], town);
+        names.push_back(buffer);
+    }
+    return names;
+}
+
+// Looks up names picked at random and sums the template indices found, so that the lookups
+// cannot be optimised away. Misses add nothing.
+template <typename Lookup>
+void TimeLookups(const char* label, const eastl::vector<eastl::string>& queries, size_t lookupCount, Lookup lookup)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookupCount; ++i)
+    {
+        const eastl::string& query = queries[NextRandom(state) % queries.size()];
+        checksum += lookup(eastl::string_view(query.data(), query.length()));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+    printf("  %-10s %8.1f ms  %6.1f ns/lookup  (checksum %llu)\n", label, nanoseconds / 1e6,
+        nanoseconds / static_cast<double>(lookupCount), static_cast<unsigned long long>(checksum));
+}
+
+template <typename Build, typename Lookup>
+void RunBenchmark(const char* label, const eastl::vector<eastl::string>& names, const eastl::vector<eastl::string>& misses,
+    size_t lookupCount, Build build, Lookup lookup)
+{
+    printf("%s\n", label);
+
+    auto start = std::chrono::steady_clock::now();
+    build();
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("  %-10s %8.1f ms\n", "build", milliseconds);
+
+    TimeLookups("hits", names, lookupCount, lookup);
+    TimeLookups("misses", misses, lookupCount, lookup);
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t lookupCount = argc > 2 ? strtoull(argv[2], nullptr, 10) : 10000000;
+    if (nameCount == 0 || lookupCount == 0)
+    {
+        printf("Usage: StringViewMapBenchmark [nameCount] [lookupCount]\n");
+        return 1;
+    }
+
+    eastl::vector<eastl::string> names = MakeNames(nameCount, "Springfield");
+    eastl::vector<eastl::string> misses = MakeNames(nameCount, "Shelbyville");
+    printf("%zu names, %zu random lookups\n", nameCount, lookupCount);
+
+    {
+        eastl::hash_map<eastl::string, uint32_t> routes;
+        RunBenchmark("eastl::hash_map<eastl::string, uint32_t>", names, misses, lookupCount,
+            [&]
+            {
+                for (size_t i = 0; i < names.size(); ++i)
+                {
+                    routes.insert(eastl::make_pair(names[i], static_cast<uint32_t>(i % TEMPLATE_COUNT)));
+                }
+            },
+            [&](eastl::string_view name) -> uint32_t
+            {
+                auto it = routes.find_as(name, eastl::hash<eastl::string_view>(), eastl::equal_to_2<eastl::string, eastl::string_view>());
+                return it != routes.end() ? it->second : 0;
+            });
+    }
+
+    {
+        // Keys point into 'names', which outlives the map.
+        eastl::hash_map<eastl::string_view, uint32_t> routes;
+        RunBenchmark("eastl::hash_map<eastl::string_view, uint32_t>", names, misses, lookupCount,
+            [&]
+            {
+                for (size_t i = 0; i < names.size(); ++i)
+                {
+                    routes.insert(eastl::make_pair(eastl::string_view(names[i].data(), names[i].length()), static_cast<uint32_t>(i % TEMPLATE_COUNT)));
+                }
+            },
+            [&](eastl::string_view name) -> uint32_t
+            {
+                auto it = routes.find(name);
+                return it != routes.end() ? it->second : 0;
+            });
+    }
+
+    {
+        StringViewMap<uint32_t> routes;
+        RunBenchmark("StringViewMap<uint32_t>", names, misses, lookupCount,
+            [&]
+            {
+                for (size_t i = 0; i < names.size(); ++i)
+                {
+                    routes.Insert(eastl::string_view(names[i].data(), names[i].length()), static_cast<uint32_t>(i % TEMPLATE_COUNT));
+                }
+            },
+            [&](eastl::string_view name) -> uint32_t
+            {
+                const uint32_t* route = routes.Find(name);
+                return route != nullptr ? *route : 0;
+            });
+        printf("  %zu slots, %zu KB of keys\n", routes.GetCapacity(), routes.GetKeyBytes() / 1024);
+    }
+
+    return 0;
+}
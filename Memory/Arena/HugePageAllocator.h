@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/string.h>
+#include "HugePageArena.h"
+
+// An EASTL allocator that allocates from a HugePageArena, eg:
+//     HugePageArena arena;
+//     HugePageString name("Amanda Hugginkiss", HugePageAllocator(&arena));
+// Deallocation is a no-op; the memory is returned when the arena is reset, so this suits
+// containers that are built once and read many times. EASTL containers do not check for a null
+// allocation, so running out of memory aborts.
+class HugePageAllocator
+{
+public:
+    explicit HugePageAllocator(const char* name = "HugePageAllocator") : mArena(&GetDefaultHugePageArena()), mName(name) {}
+    explicit HugePageAllocator(HugePageArena* arena, const char* name = "HugePageAllocator") : mArena(arena), mName(name) {}
+
+    void* allocate(size_t n, int flags = 0)
+    {
+        return CheckAllocation(mArena->Allocate(n), n);
+    }
+
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+    {
+        return CheckAllocation(mArena->Allocate(n, alignment), n);
+    }
+
+    void deallocate(void* p, size_t n) {}
+
+    const char* get_name() const { return mName; }
+    void set_name(const char* name) { mName = name; }
+
+    HugePageArena* GetArena() const { return mArena; }
+
+private:
+    void* CheckAllocation(void* p, size_t n) const
+    {
+        if (p == nullptr)
+        {
+            fprintf(stderr, "%s could not allocate %zu bytes\n", mName, n);
+            abort();
+        }
+        return p;
+    }
+
+    HugePageArena* mArena;
+    const char* mName;
+};
+
+inline bool operator==(const HugePageAllocator& a, const HugePageAllocator& b)
+{
+    return a.GetArena() == b.GetArena();
+}
+
+inline bool operator!=(const HugePageAllocator& a, const HugePageAllocator& b)
+{
+    return a.GetArena() != b.GetArena();
+}
+
+typedef eastl::basic_string<char, HugePageAllocator> HugePageString;
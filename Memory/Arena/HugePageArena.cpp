@@ -0,0 +1,155 @@
+#include "HugePageArena.h"
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+    size_t RoundUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+#if defined(_WIN32)
+    void* MapPages(size_t size, HugePageMode mode, bool& explicitHugePages)
+    {
+        explicitHugePages = false;
+        return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+
+    void UnmapPages(void* base, size_t size)
+    {
+        VirtualFree(base, 0, MEM_RELEASE);
+    }
+#else
+    void* MapAnonymous(size_t size, int flags)
+    {
+        void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+        return base != MAP_FAILED ? base : nullptr;
+    }
+
+    void* MapPages(size_t size, HugePageMode mode, bool& explicitHugePages)
+    {
+        explicitHugePages = false;
+
+#if defined(MAP_HUGETLB)
+        if (mode == HugePageMode::Explicit)
+        {
+            if (void* base = MapAnonymous(size, MAP_HUGETLB))
+            {
+                explicitHugePages = true;
+                return base;
+            }
+        }
+#endif
+
+        if (mode == HugePageMode::None)
+        {
+            return MapAnonymous(size, 0);
+        }
+
+        // Over-map by one huge page and trim so the region starts on a 2MB boundary; the kernel
+        // can only back aligned 2MB ranges with a huge page.
+        size_t mappedSize = size + HugePageArena::HUGE_PAGE_SIZE;
+        char* mapped = static_cast<char*>(MapAnonymous(mappedSize, 0));
+        if (mapped == nullptr)
+        {
+            return nullptr;
+        }
+
+        char* base = reinterpret_cast<char*>(RoundUp(reinterpret_cast<uintptr_t>(mapped), HugePageArena::HUGE_PAGE_SIZE));
+        if (base != mapped)
+        {
+            munmap(mapped, static_cast<size_t>(base - mapped));
+        }
+        size_t tail = static_cast<size_t>((mapped + mappedSize) - (base + size));
+        if (tail > 0)
+        {
+            munmap(base + size, tail);
+        }
+
+#if defined(MADV_HUGEPAGE)
+        madvise(base, size, MADV_HUGEPAGE);
+#endif
+        return base;
+    }
+
+    void UnmapPages(void* base, size_t size)
+    {
+        munmap(base, size);
+    }
+#endif
+}
+
+HugePageArena::HugePageArena(HugePageMode mode, size_t chunkSize)
+    : mMode(mode), mChunkSize(RoundUp(chunkSize > 0 ? chunkSize : HUGE_PAGE_SIZE, HUGE_PAGE_SIZE))
+{
+}
+
+HugePageArena::~HugePageArena()
+{
+    Reset();
+}
+
+void* HugePageArena::Allocate(size_t size, size_t alignment)
+{
+    char* start = reinterpret_cast<char*>(RoundUp(reinterpret_cast<uintptr_t>(mCursor), alignment));
+    if (mCursor == nullptr || start + size > mEnd)
+    {
+        if (!MapChunk(size + alignment))
+        {
+            return nullptr;
+        }
+        start = reinterpret_cast<char*>(RoundUp(reinterpret_cast<uintptr_t>(mCursor), alignment));
+    }
+
+    mCursor = start + size;
+    mUsedBytes += size;
+    return start;
+}
+
+void HugePageArena::Reset()
+{
+    for (const Chunk& chunk : mChunks)
+    {
+        UnmapPages(chunk.base, chunk.size);
+    }
+
+    mChunks.clear();
+    mCursor = nullptr;
+    mEnd = nullptr;
+    mReservedBytes = 0;
+    mUsedBytes = 0;
+    mExplicitHugePageBytes = 0;
+}
+
+bool HugePageArena::MapChunk(size_t minimumSize)
+{
+    size_t size = minimumSize > mChunkSize ? RoundUp(minimumSize, HUGE_PAGE_SIZE) : mChunkSize;
+
+    bool explicitHugePages = false;
+    void* base = MapPages(size, mMode, explicitHugePages);
+    if (base == nullptr)
+    {
+        return false;
+    }
+
+    mChunks.push_back({ base, size });
+    mCursor = static_cast<char*>(base);
+    mEnd = mCursor + size;
+    mReservedBytes += size;
+    mExplicitHugePageBytes += explicitHugePages ? size : 0;
+    return true;
+}
+
+HugePageArena& GetDefaultHugePageArena()
+{
+    // Never destroyed, so strings that outlive static destruction keep valid storage.
+    static HugePageArena* arena = new HugePageArena();
+    return *arena;
+}
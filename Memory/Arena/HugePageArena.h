@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <EASTL/vector.h>
+
+enum class HugePageMode
+{
+    // Regular pages.
+    None,
+    // 2MB aligned regions advised with MADV_HUGEPAGE so transparent huge pages can back them.
+    Transparent,
+    // MAP_HUGETLB regions from the reserved huge page pool, falling back to Transparent when the
+    // pool is empty or not configured.
+    Explicit
+};
+
+// A bump arena that maps its memory in large chunks backed by 2MB pages where the platform
+// allows it. With hundreds of millions of small names resident, 4KB pages cost a TLB miss on
+// almost every random access; 2MB pages cut the number of pages by 512x.
+//
+// Individual allocations are never freed; memory is returned by Reset() or on destruction. The
+// arena is not thread-safe.
+class HugePageArena
+{
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    explicit HugePageArena(HugePageMode mode = HugePageMode::Transparent, size_t chunkSize = 32 * HUGE_PAGE_SIZE);
+    ~HugePageArena();
+
+    HugePageArena(const HugePageArena&) = delete;
+    HugePageArena& operator=(const HugePageArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(max_align_t));
+
+    // Releases every chunk. Anything allocated from the arena is invalidated.
+    void Reset();
+
+    HugePageMode GetMode() const { return mMode; }
+    size_t GetReservedBytes() const { return mReservedBytes; }
+    size_t GetUsedBytes() const { return mUsedBytes; }
+
+    // Bytes mapped with MAP_HUGETLB. Transparent huge page coverage is decided by the kernel and
+    // is reported in /proc/self/smaps as AnonHugePages.
+    size_t GetExplicitHugePageBytes() const { return mExplicitHugePageBytes; }
+
+private:
+    struct Chunk
+    {
+        void* base;
+        size_t size;
+    };
+
+    bool MapChunk(size_t minimumSize);
+
+    HugePageMode mMode;
+    size_t mChunkSize;
+    char* mCursor = nullptr;
+    char* mEnd = nullptr;
+    size_t mReservedBytes = 0;
+    size_t mUsedBytes = 0;
+    size_t mExplicitHugePageBytes = 0;
+    eastl::vector<Chunk> mChunks;
+};
+
+// A process-wide arena for default constructed HugePageAllocators. Like any HugePageArena it is
+// not thread-safe.
+HugePageArena& GetDefaultHugePageArena();
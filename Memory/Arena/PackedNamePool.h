@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstring>
+#include <EASTL/string.h>
+
+// Append-only storage for names packed back to back in an arena, with no per-name header or
+// terminator. Names are read back as eastl::string_views, which stay valid as long as the arena.
+// Append() returns an empty view, and stores nothing, if the arena is out of memory.
+template <typename Arena>
+class PackedNamePool
+{
+public:
+    explicit PackedNamePool(Arena& arena) : mArena(arena) {}
+
+    eastl::string_view Append(eastl::string_view name)
+    {
+        char* storage = static_cast<char*>(mArena.Allocate(name.length(), 1));
+        if (storage == nullptr)
+        {
+            return eastl::string_view();
+        }
+        memcpy(storage, name.data(), name.length());
+        mBytes += name.length();
+        ++mCount;
+        return eastl::string_view(storage, name.length());
+    }
+
+    size_t GetCount() const { return mCount; }
+    size_t GetBytes() const { return mBytes; }
+
+private:
+    Arena& mArena;
+    size_t mCount = 0;
+    size_t mBytes = 0;
+};
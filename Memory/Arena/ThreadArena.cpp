@@ -0,0 +1,238 @@
+#include "ThreadArena.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    constexpr uint32_t LARGE_SIZE_CLASS = ThreadArena::SIZE_CLASS_COUNT;
+
+    void* AllocateSpanMemory(size_t size)
+    {
+#if defined(_WIN32)
+        return _aligned_malloc(size, ThreadArena::SPAN_SIZE);
+#else
+        void* memory = nullptr;
+        return posix_memalign(&memory, ThreadArena::SPAN_SIZE, size) == 0 ? memory : nullptr;
+#endif
+    }
+
+    void FreeSpanMemory(void* memory)
+    {
+#if defined(_WIN32)
+        _aligned_free(memory);
+#else
+        free(memory);
+#endif
+    }
+
+    std::mutex gParkedMutex;
+    ThreadArena* gParkedArenas[256] = {};
+    size_t gParkedCount = 0;
+
+    thread_local ThreadArena* tCurrentArena = nullptr;
+    thread_local bool tArenaParked = false;
+}
+
+struct ThreadArena::Holder
+{
+    ThreadArena* arena;
+
+    Holder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(gParkedMutex);
+            arena = gParkedCount > 0 ? gParkedArenas[--gParkedCount] : nullptr;
+        }
+
+        if (arena == nullptr)
+        {
+            arena = new ThreadArena();
+        }
+    }
+
+    // Parks the arena for the next thread. If too many are parked the arena is simply leaked;
+    // its blocks stay valid and remote frees keep landing on it.
+    ~Holder()
+    {
+        tCurrentArena = nullptr;
+        tArenaParked = true;
+
+        std::lock_guard<std::mutex> lock(gParkedMutex);
+        if (gParkedCount < sizeof(gParkedArenas) / sizeof(gParkedArenas[0]))
+        {
+            gParkedArenas[gParkedCount++] = arena;
+        }
+    }
+};
+
+ThreadArena& ThreadArena::Get()
+{
+    if (tCurrentArena == nullptr)
+    {
+        if (tArenaParked)
+        {
+            // Allocating during thread teardown, after this thread's arena was handed back.
+            tCurrentArena = new ThreadArena();
+        }
+        else
+        {
+            thread_local Holder holder;
+            tCurrentArena = holder.arena;
+        }
+    }
+    return *tCurrentArena;
+}
+
+uint32_t ThreadArena::GetSizeClass(size_t size)
+{
+    uint32_t sizeClass = 0;
+    size_t blockSize = MIN_BLOCK_SIZE;
+    while (blockSize < size)
+    {
+        blockSize *= 2;
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+ThreadArena::SpanHeader* ThreadArena::GetSpan(void* block)
+{
+    return reinterpret_cast<SpanHeader*>(reinterpret_cast<uintptr_t>(block) & ~(uintptr_t)(SPAN_SIZE - 1));
+}
+
+void* ThreadArena::Allocate(size_t size, size_t alignment)
+{
+    ++mAllocations;
+
+    // Blocks are aligned to their size up to the 64 byte span header, so an over-aligned request
+    // just moves up a size class.
+    size_t blockSize = size > alignment ? size : alignment;
+    if (blockSize > MAX_BLOCK_SIZE || alignment > SPAN_HEADER_SIZE)
+    {
+        return AllocateLarge(size, alignment);
+    }
+
+    uint32_t sizeClass = GetSizeClass(blockSize);
+    FreeBlock* block = mFreeLists[sizeClass];
+    if (block == nullptr && DrainRemoteFrees())
+    {
+        block = mFreeLists[sizeClass];
+    }
+
+    if (block != nullptr)
+    {
+        mFreeLists[sizeClass] = block->next;
+        return block;
+    }
+
+    if (mCarveCursors[sizeClass] == mCarveEnds[sizeClass] && !CarveSpan(sizeClass))
+    {
+        return nullptr;
+    }
+
+    void* carved = mCarveCursors[sizeClass];
+    mCarveCursors[sizeClass] += MIN_BLOCK_SIZE << sizeClass;
+    return carved;
+}
+
+void ThreadArena::Free(void* block)
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+
+    SpanHeader* span = GetSpan(block);
+    if (span->sizeClass == LARGE_SIZE_CLASS)
+    {
+        FreeSpanMemory(span);
+        return;
+    }
+
+    ThreadArena* owner = span->owner;
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    if (owner == tCurrentArena)
+    {
+        ++owner->mLocalFrees;
+        owner->PushLocal(freeBlock, span->sizeClass);
+        return;
+    }
+
+    // Many producers, one consumer that takes the whole list at once, so a plain CAS push is
+    // free of ABA problems.
+    FreeBlock* head = owner->mRemoteFrees.load(std::memory_order_relaxed);
+    do
+    {
+        freeBlock->next = head;
+    } while (!owner->mRemoteFrees.compare_exchange_weak(head, freeBlock, std::memory_order_release, std::memory_order_relaxed));
+}
+
+ThreadArena::Stats ThreadArena::GetStats() const
+{
+    return { mAllocations, mLocalFrees, mRemoteFreesReceived, mSpanBytes };
+}
+
+void* ThreadArena::AllocateLarge(size_t size, size_t alignment)
+{
+    size_t offset = alignment > SPAN_HEADER_SIZE ? alignment : SPAN_HEADER_SIZE;
+    if (offset >= SPAN_SIZE)
+    {
+        return nullptr;
+    }
+
+    size_t spanSize = (offset + size + SPAN_SIZE - 1) & ~(SPAN_SIZE - 1);
+    void* memory = AllocateSpanMemory(spanSize);
+    if (memory == nullptr)
+    {
+        return nullptr;
+    }
+
+    SpanHeader* span = new (memory) SpanHeader{ nullptr, LARGE_SIZE_CLASS };
+    return reinterpret_cast<char*>(span) + offset;
+}
+
+void ThreadArena::PushLocal(FreeBlock* block, uint32_t sizeClass)
+{
+    block->next = mFreeLists[sizeClass];
+    mFreeLists[sizeClass] = block;
+}
+
+bool ThreadArena::DrainRemoteFrees()
+{
+    FreeBlock* block = mRemoteFrees.exchange(nullptr, std::memory_order_acquire);
+    if (block == nullptr)
+    {
+        return false;
+    }
+
+    while (block != nullptr)
+    {
+        FreeBlock* next = block->next;
+        PushLocal(block, GetSpan(block)->sizeClass);
+        ++mRemoteFreesReceived;
+        block = next;
+    }
+    return true;
+}
+
+bool ThreadArena::CarveSpan(uint32_t sizeClass)
+{
+    void* memory = AllocateSpanMemory(SPAN_SIZE);
+    if (memory == nullptr)
+    {
+        return false;
+    }
+
+    SpanHeader* span = new (memory) SpanHeader{ this, sizeClass };
+    mCarveCursors[sizeClass] = reinterpret_cast<char*>(span) + SPAN_HEADER_SIZE;
+    mCarveEnds[sizeClass] = reinterpret_cast<char*>(span) + SPAN_HEADER_SIZE +
+        ((SPAN_SIZE - SPAN_HEADER_SIZE) / (MIN_BLOCK_SIZE << sizeClass)) * (MIN_BLOCK_SIZE << sizeClass);
+    mSpanBytes += SPAN_SIZE;
+    return true;
+}
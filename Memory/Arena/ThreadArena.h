@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// A per-thread heap. Each thread allocates from its own arena without locks; a block freed by
+// the thread that allocated it goes straight back on that thread's free list, and a block freed by
+// any other thread is pushed onto the owning arena's lock-free remote free list, which the owner
+// drains the next time it runs short. This suits pipelines where one thread materializes strings
+// and others release them.
+//
+// Small blocks come from power of two size classes carved out of 64KB spans; the span header
+// records the owning arena so a free never needs a lookup. Larger blocks get a span of their own.
+// When a thread exits its arena is parked and adopted by the next new thread, so blocks that are
+// still alive elsewhere stay valid and the memory is reused.
+class ThreadArena
+{
+public:
+    static constexpr size_t SPAN_SIZE = 64 * 1024;
+    static constexpr size_t SPAN_HEADER_SIZE = 64;
+    static constexpr size_t MIN_BLOCK_SIZE = 16;
+    static constexpr size_t MAX_BLOCK_SIZE = 2048;
+    static constexpr uint32_t SIZE_CLASS_COUNT = 8;
+
+    struct Stats
+    {
+        uint64_t allocations;
+        uint64_t localFrees;
+        uint64_t remoteFreesReceived;
+        size_t spanBytes;
+    };
+
+    // The calling thread's arena.
+    static ThreadArena& Get();
+
+    void* Allocate(size_t size, size_t alignment = MIN_BLOCK_SIZE);
+
+    // Frees a block from any thread's arena, from any thread.
+    static void Free(void* block);
+
+    Stats GetStats() const;
+
+private:
+    struct Holder;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct SpanHeader
+    {
+        ThreadArena* owner;
+        uint32_t sizeClass;
+    };
+
+    // Arenas are parked rather than destroyed, as blocks may outlive their thread.
+    ThreadArena() = default;
+    ~ThreadArena() = delete;
+
+    static uint32_t GetSizeClass(size_t size);
+    static SpanHeader* GetSpan(void* block);
+
+    void* AllocateLarge(size_t size, size_t alignment);
+    void PushLocal(FreeBlock* block, uint32_t sizeClass);
+    bool DrainRemoteFrees();
+    bool CarveSpan(uint32_t sizeClass);
+
+    FreeBlock* mFreeLists[SIZE_CLASS_COUNT] = {};
+    char* mCarveCursors[SIZE_CLASS_COUNT] = {};
+    char* mCarveEnds[SIZE_CLASS_COUNT] = {};
+    size_t mSpanBytes = 0;
+    uint64_t mAllocations = 0;
+    uint64_t mLocalFrees = 0;
+    uint64_t mRemoteFreesReceived = 0;
+
+    // Written by other threads, so kept off the cache lines the owner uses.
+    alignas(64) std::atomic<FreeBlock*> mRemoteFrees{ nullptr };
+    char mRemotePadding[64 - sizeof(std::atomic<FreeBlock*>)];
+};
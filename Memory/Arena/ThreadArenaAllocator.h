@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/string.h>
+#include "ThreadArena.h"
+
+// An EASTL allocator over the calling thread's ThreadArena. Containers and strings may be freed
+// on any thread; blocks freed away from their owner go back through its remote free list. EASTL
+// containers do not check for a null allocation, so running out of memory aborts.
+class ThreadArenaAllocator
+{
+public:
+    explicit ThreadArenaAllocator(const char* name = "ThreadArenaAllocator") : mName(name) {}
+
+    void* allocate(size_t n, int flags = 0)
+    {
+        return CheckAllocation(ThreadArena::Get().Allocate(n), n);
+    }
+
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+    {
+        return CheckAllocation(ThreadArena::Get().Allocate(n, alignment), n);
+    }
+
+    void deallocate(void* p, size_t n)
+    {
+        ThreadArena::Free(p);
+    }
+
+    const char* get_name() const { return mName; }
+    void set_name(const char* name) { mName = name; }
+
+private:
+    void* CheckAllocation(void* p, size_t n) const
+    {
+        if (p == nullptr)
+        {
+            fprintf(stderr, "%s could not allocate %zu bytes\n", mName, n);
+            abort();
+        }
+        return p;
+    }
+
+    const char* mName;
+};
+
+// Any ThreadArenaAllocator can free what another allocated.
+inline bool operator==(const ThreadArenaAllocator&, const ThreadArenaAllocator&)
+{
+    return true;
+}
+
+inline bool operator!=(const ThreadArenaAllocator&, const ThreadArenaAllocator&)
+{
+    return false;
+}
+
+typedef eastl::basic_string<char, ThreadArenaAllocator> ThreadString;
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "CompressedNamePool.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// Every SAMPLE_INTERVAL-th name is used to train the symbol table. The interval is prime so that
+// the sample covers every first name and surname.
+constexpr size_t SAMPLE_INTERVAL = 101;
+
+uint64_t NextRandom(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+size_t MakeName(size_t index, char* buffer, size_t capacity)
+{
+    int length = snprintf(buffer, capacity, "%s%zu %s of Springfield", FIRST_NAMES[index % 10], index, SURNAMES[(index / 10) % 10]);
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+// Decodes the whole name once; the first name's length comes from the codes rather than a
+// search of the decoded text.
+size_t PrankMoe(const CompressedNamePool& pool, uint32_t id, char* buffer, size_t capacity)
+{
+    char fullName[128];
+    size_t fullNameLength = pool.Decode(id, fullName, sizeof(fullName));
+    size_t firstNameLength = pool.GetFirstNameLength(id);
+    if (firstNameLength == CompressedNamePool::npos)
+    {
+        firstNameLength = fullNameLength;
+    }
+
+    int length = snprintf(buffer, capacity, MOE_DIALOGUE_1, static_cast<int>(firstNameLength), fullName,
+        static_cast<int>(fullNameLength), fullName);
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+template <typename Operation>
+void TimeRandomIds(const char* label, size_t nameCount, size_t lookupCount, Operation operation)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookupCount; ++i)
+    {
+        checksum += operation(static_cast<uint32_t>(NextRandom(state) % nameCount));
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-40s %8.1f ms  %6.1f ns/name  (checksum %llu)\n", label, nanoseconds / 1e6,
+        nanoseconds / static_cast<double>(lookupCount), static_cast<unsigned long long>(checksum));
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000000;
+    size_t lookupCount = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000000;
+    if (nameCount == 0 || lookupCount == 0)
+    {
+        printf("Usage: CompressedPoolBenchmark [nameCount] [lookupCount]\n");
+        return 1;
+    }
+
+    char name[128];
+    eastl::vector<eastl::string> sampleNames;
+    for (size_t i = 0; i < nameCount; i += SAMPLE_INTERVAL)
+    {
+        sampleNames.push_back(eastl::string(name, MakeName(i, name, sizeof(name))));
+    }
+    eastl::vector<eastl::string_view> sample;
+    for (const eastl::string& sampleName : sampleNames)
+    {
+        sample.push_back(eastl::string_view(sampleName.data(), sampleName.length()));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SymbolTable symbols;
+    symbols.Train(sample);
+    double trainMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    CompressedNamePool pool(symbols);
+    size_t nameBytes = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        size_t length = MakeName(i, name, sizeof(name));
+        pool.Append(eastl::string_view(name, length));
+        nameBytes += length;
+    }
+    double appendMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // A packed pool stores the characters plus a view per name.
+    size_t packedBytes = nameBytes + nameCount * sizeof(eastl::string_view);
+
+    printf("%zu names, %zu symbols trained on %zu names in %.1f ms, appended in %.1f ms\n", nameCount,
+        symbols.GetSymbolCount(), sample.size(), trainMilliseconds, appendMilliseconds);
+    printf("%-40s %10zu KB  %5.1f bytes/name\n", "eastl::string_view + packed pool", packedBytes / 1024, static_cast<double>(packedBytes) / static_cast<double>(nameCount));
+    printf("%-40s %10zu KB  %5.1f bytes/name\n", "CompressedNamePool", pool.GetCompressedBytes() / 1024, static_cast<double>(pool.GetCompressedBytes()) / static_cast<double>(nameCount));
+
+    char buffer[256];
+    TimeRandomIds("Decode()", nameCount, lookupCount, [&](uint32_t id)
+    {
+        return pool.Decode(id, buffer, sizeof(buffer));
+    });
+
+    TimeRandomIds("first name: Decode() + find", nameCount, lookupCount, [&](uint32_t id)
+    {
+        size_t length = pool.Decode(id, buffer, sizeof(buffer));
+        size_t delimiterPosition = eastl::string_view(buffer, length < sizeof(buffer) ? length : sizeof(buffer)).find(' ');
+        return delimiterPosition != eastl::string_view::npos ? delimiterPosition : length;
+    });
+
+    TimeRandomIds("first name: DecodeFirstName()", nameCount, lookupCount, [&](uint32_t id)
+    {
+        size_t length = pool.DecodeFirstName(id, buffer, sizeof(buffer));
+        return length != CompressedNamePool::npos ? length : 0;
+    });
+
+    TimeRandomIds("first name: GetFirstNameLength()", nameCount, lookupCount, [&](uint32_t id)
+    {
+        size_t length = pool.GetFirstNameLength(id);
+        return length != CompressedNamePool::npos ? length : 0;
+    });
+
+    TimeRandomIds("PrankMoe()", nameCount, lookupCount, [&](uint32_t id)
+    {
+        return PrankMoe(pool, id, buffer, sizeof(buffer));
+    });
+
+    return 0;
+}
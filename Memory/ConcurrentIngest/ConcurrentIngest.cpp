@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "ConcurrentNamePool.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// Stands in for parsing a record from an input shard.
+size_t ParseName(size_t index, char* buffer, size_t capacity)
+{
+    int length = snprintf(buffer, capacity, "%s%zu %s of Springfield", FIRST_NAMES[index % 10], index, SURNAMES[(index / 10) % 10]);
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+size_t PrankMoe(eastl::string_view fullName, char* buffer, size_t capacity)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    size_t firstNameLength = delimiterPosition != eastl::string_view::npos ? delimiterPosition : fullName.length();
+
+    int length = snprintf(buffer, capacity, MOE_DIALOGUE_1, static_cast<int>(firstNameLength), fullName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+// The batch path takes views, wherever they are stored.
+size_t PrankMoeBatch(const eastl::vector<eastl::string_view>& names)
+{
+    char buffer[256];
+    size_t bytes = 0;
+    for (eastl::string_view fullName : names)
+    {
+        bytes += PrankMoe(fullName, buffer, sizeof(buffer));
+    }
+    return bytes;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Ingest>
+void RunIngestion(const char* label, size_t nameCount, unsigned threadCount, Ingest ingest)
+{
+    auto start = std::chrono::steady_clock::now();
+    eastl::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t)
+    {
+        size_t begin = nameCount * t / threadCount;
+        size_t end = nameCount * (t + 1) / threadCount;
+        threads.push_back(std::thread([&ingest, t, begin, end] { ingest(t, begin, end); }));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    double milliseconds = MillisecondsSince(start);
+    printf("%-44s %8.1f ms  %6.1f ns/name\n", label, milliseconds, milliseconds * 1e6 / static_cast<double>(nameCount));
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000000;
+    unsigned threadCount = argc > 2 ? static_cast<unsigned>(strtoul(argv[2], nullptr, 10)) : 4;
+    if (nameCount == 0 || threadCount == 0)
+    {
+        printf("Usage: ConcurrentIngest [nameCount] [threads]\n");
+        return 1;
+    }
+
+    printf("%zu names, %u ingestion threads\n", nameCount, threadCount);
+
+    // Every thread pushes into one shared vector of owning strings.
+    std::mutex mutex;
+    eastl::vector<eastl::string> shared;
+    shared.reserve(nameCount);
+    RunIngestion("mutex + eastl::vector<eastl::string>", nameCount, threadCount, [&](unsigned, size_t begin, size_t end)
+    {
+        char name[64];
+        for (size_t i = begin; i < end; ++i)
+        {
+            size_t length = ParseName(i, name, sizeof(name));
+            std::lock_guard<std::mutex> lock(mutex);
+            shared.push_back(eastl::string(name, length));
+        }
+    });
+
+    // Every thread appends to the shared pool through its own appender and keeps its own views.
+    ConcurrentNamePool pool;
+    eastl::vector<eastl::vector<eastl::string_view>> views(threadCount);
+    RunIngestion("ConcurrentNamePool appenders", nameCount, threadCount, [&](unsigned t, size_t begin, size_t end)
+    {
+        char name[64];
+        ConcurrentNamePool::Appender appender(pool);
+        eastl::vector<eastl::string_view>& threadViews = views[t];
+        threadViews.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i)
+        {
+            threadViews.push_back(appender.Append(eastl::string_view(name, ParseName(i, name, sizeof(name)))));
+        }
+    });
+    printf("%-44s %zu MB claimed, %zu MB reserved\n", "", pool.GetClaimedBytes() / (1024 * 1024), pool.GetReservedBytes() / (1024 * 1024));
+
+    // The pooled views feed the batch path as they are; the strings have to be viewed first.
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+    for (const eastl::vector<eastl::string_view>& threadViews : views)
+    {
+        bytes += PrankMoeBatch(threadViews);
+    }
+    printf("%-44s %8.1f ms  %zu bytes formatted\n", "PrankMoeBatch over pooled views", MillisecondsSince(start), bytes);
+
+    start = std::chrono::steady_clock::now();
+    eastl::vector<eastl::string_view> sharedViews;
+    sharedViews.reserve(shared.size());
+    for (const eastl::string& name : shared)
+    {
+        sharedViews.push_back(eastl::string_view(name.data(), name.length()));
+    }
+    bytes = PrankMoeBatch(sharedViews);
+    printf("%-44s %8.1f ms  %zu bytes formatted\n", "PrankMoeBatch over eastl::strings", MillisecondsSince(start), bytes);
+
+    return 0;
+}
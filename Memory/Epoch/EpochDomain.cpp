@@ -0,0 +1,87 @@
+#include "EpochDomain.h"
+
+EpochDomain::~EpochDomain()
+{
+    for (const RetiredObject& retired : mRetired)
+    {
+        retired.destroy(retired.object);
+    }
+}
+
+void EpochDomain::Pin()
+{
+    ReaderSlot& slot = mSlots[GetThreadIndex()];
+    if (slot.depth++ == 0)
+    {
+        slot.epoch.store(mEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        // The pin must be visible before any shared pointer is read under it.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void EpochDomain::Unpin()
+{
+    ReaderSlot& slot = mSlots[GetThreadIndex()];
+    if (--slot.depth == 0)
+    {
+        slot.epoch.store(0, std::memory_order_release);
+    }
+}
+
+void EpochDomain::Retire(void* object, void (*destroy)(void*))
+{
+    std::lock_guard<std::mutex> lock(mRetiredMutex);
+
+    // Readers that pin after this increment cannot reach 'object', so it is safe to destroy
+    // once every reader pinned at or before 'epoch' has left.
+    uint64_t epoch = mEpoch.fetch_add(1, std::memory_order_seq_cst);
+    mRetired.push_back({ object, destroy, epoch });
+    CollectLocked();
+}
+
+void EpochDomain::Collect()
+{
+    std::lock_guard<std::mutex> lock(mRetiredMutex);
+    CollectLocked();
+}
+
+size_t EpochDomain::GetRetiredCount() const
+{
+    std::lock_guard<std::mutex> lock(mRetiredMutex);
+    return mRetired.size();
+}
+
+void EpochDomain::CollectLocked()
+{
+    if (mRetired.empty())
+    {
+        return;
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t oldestPinned = UINT64_MAX;
+    for (const ReaderSlot& slot : mSlots)
+    {
+        uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+        if (epoch != 0 && epoch < oldestPinned)
+        {
+            oldestPinned = epoch;
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < mRetired.size(); ++i)
+    {
+        if (mRetired[i].epoch < oldestPinned)
+        {
+            mRetired[i].destroy(mRetired[i].object);
+        }
+        else
+        {
+            mRetired[kept++] = mRetired[i];
+        }
+    }
+    mRetired.resize(kept);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <EASTL/vector.h>
+#include "ThreadIndex.h"
+
+// Epoch based reclamation. Readers pin the domain while they hold pointers into a shared
+// structure; writers unlink objects and retire them, and a retired object is only destroyed once
+// every reader that might have seen it has unpinned. Pinning touches a single cache line owned by
+// the calling thread, so readers never contend with each other.
+class EpochDomain
+{
+public:
+    class Guard
+    {
+    public:
+        explicit Guard(EpochDomain& domain) : mDomain(&domain) { mDomain->Pin(); }
+        Guard(Guard&& other) : mDomain(other.mDomain) { other.mDomain = nullptr; }
+        ~Guard() { if (mDomain != nullptr) mDomain->Unpin(); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+    private:
+        EpochDomain* mDomain;
+    };
+
+    EpochDomain() = default;
+    ~EpochDomain();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Pins may nest on the same thread.
+    void Pin();
+    void Unpin();
+
+    // Destroys 'object' once no reader can still hold it. The object must already be unreachable
+    // for new readers.
+    template <typename T>
+    void Retire(T* object)
+    {
+        Retire(object, [](void* retired) { delete static_cast<T*>(retired); });
+    }
+
+    void Retire(void* object, void (*destroy)(void*));
+
+    // Destroys retired objects that are no longer visible to any reader.
+    void Collect();
+
+    size_t GetRetiredCount() const;
+
+private:
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<uint64_t> epoch{ 0 };
+        uint32_t depth = 0;
+    };
+
+    struct RetiredObject
+    {
+        void* object;
+        void (*destroy)(void*);
+        uint64_t epoch;
+    };
+
+    void CollectLocked();
+
+    std::atomic<uint64_t> mEpoch{ 1 };
+    ReaderSlot mSlots[MAX_THREADS];
+
+    mutable std::mutex mRetiredMutex;
+    eastl::vector<RetiredObject> mRetired;
+};
@@ -0,0 +1,44 @@
+#include "ThreadIndex.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+namespace
+{
+    std::mutex gIndexMutex;
+    bool gIndexInUse[MAX_THREADS] = {};
+
+    uint32_t AcquireThreadIndex()
+    {
+        std::lock_guard<std::mutex> lock(gIndexMutex);
+        for (uint32_t i = 0; i < MAX_THREADS; ++i)
+        {
+            if (!gIndexInUse[i])
+            {
+                gIndexInUse[i] = true;
+                return i;
+            }
+        }
+
+        fprintf(stderr, "More than %u threads need a thread index\n", MAX_THREADS);
+        abort();
+    }
+
+    struct ThreadIndexHolder
+    {
+        uint32_t index = AcquireThreadIndex();
+
+        ~ThreadIndexHolder()
+        {
+            std::lock_guard<std::mutex> lock(gIndexMutex);
+            gIndexInUse[index] = false;
+        }
+    };
+}
+
+uint32_t GetThreadIndex()
+{
+    thread_local ThreadIndexHolder holder;
+    return holder.index;
+}
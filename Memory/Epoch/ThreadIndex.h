@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+constexpr uint32_t MAX_THREADS = 256;
+
+// A small dense index for the calling thread, in [0, MAX_THREADS). Indices are handed out on a
+// thread's first call and recycled when it exits, so per-thread tables can be fixed arrays.
+uint32_t GetThreadIndex();
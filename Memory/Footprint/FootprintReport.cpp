@@ -0,0 +1,96 @@
+#include "FootprintReport.h"
+
+#include <atomic>
+#include <cstdio>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    std::atomic<uint64_t> gEastlHeapBytes{ 0 };
+    std::atomic<uint64_t> gEastlHeapAllocations{ 0 };
+
+    size_t ReadResidentBytes()
+    {
+#if defined(__linux__)
+        FILE* file = fopen("/proc/self/statm", "r");
+        if (file == nullptr)
+        {
+            return 0;
+        }
+
+        unsigned long sizePages = 0;
+        unsigned long residentPages = 0;
+        int fields = fscanf(file, "%lu %lu", &sizePages, &residentPages);
+        fclose(file);
+        return fields == 2 ? static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    double Megabytes(double bytes)
+    {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    double Difference(uint64_t before, uint64_t after)
+    {
+        return static_cast<double>(after) - static_cast<double>(before);
+    }
+}
+
+void RecordEastlAllocation(size_t size)
+{
+    gEastlHeapBytes.fetch_add(size, std::memory_order_relaxed);
+    gEastlHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+FootprintSample TakeFootprintSample()
+{
+    FootprintSample sample = {};
+    sample.residentBytes = ReadResidentBytes();
+    sample.eastlHeapBytes = gEastlHeapBytes.load(std::memory_order_relaxed);
+    sample.eastlHeapAllocations = gEastlHeapAllocations.load(std::memory_order_relaxed);
+
+#if defined(__linux__) || defined(__APPLE__)
+    rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        sample.minorFaults = static_cast<uint64_t>(usage.ru_minflt);
+        sample.majorFaults = static_cast<uint64_t>(usage.ru_majflt);
+    }
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    sample.mallocInUseBytes = mallinfo2().uordblks;
+#endif
+
+    return sample;
+}
+
+void PrintFootprintHeader()
+{
+    printf("%-28s %10s %10s %10s %10s %12s %12s %10s\n", "", "RSS MB", "faults", "major", "heap MB",
+        "allocations", "malloc MB", "B/name");
+}
+
+void PrintFootprint(const char* label, const FootprintSample& before, const FootprintSample& after, size_t itemCount)
+{
+    double heapBytes = Difference(before.eastlHeapBytes, after.eastlHeapBytes);
+    printf("%-28s %10.1f %10.0f %10.0f %10.1f %12.0f %12.1f %10.1f\n", label,
+        Megabytes(Difference(before.residentBytes, after.residentBytes)),
+        Difference(before.minorFaults, after.minorFaults),
+        Difference(before.majorFaults, after.majorFaults),
+        Megabytes(heapBytes),
+        Difference(before.eastlHeapAllocations, after.eastlHeapAllocations),
+        Megabytes(Difference(before.mallocInUseBytes, after.mallocInUseBytes)),
+        itemCount > 0 ? heapBytes / static_cast<double>(itemCount) : 0.0);
+}
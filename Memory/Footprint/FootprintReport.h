@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Process memory counters at one point in time. Fields the platform cannot provide are zero.
+struct FootprintSample
+{
+    size_t residentBytes;
+    uint64_t minorFaults;
+    uint64_t majorFaults;
+    // Bytes and calls seen by the EASTL allocation hook, see RecordEastlAllocation().
+    uint64_t eastlHeapBytes;
+    uint64_t eastlHeapAllocations;
+    // Bytes in use according to the C heap (glibc mallinfo2), including non-EASTL allocations.
+    size_t mallocInUseBytes;
+};
+
+// Called from the executable's EASTL operator new[] hooks so that EASTL allocations are counted.
+void RecordEastlAllocation(size_t size);
+
+FootprintSample TakeFootprintSample();
+
+// Prints the change between two samples, plus bytes per item for 'itemCount' stored items.
+void PrintFootprint(const char* label, const FootprintSample& before, const FootprintSample& after, size_t itemCount);
+
+void PrintFootprintHeader();
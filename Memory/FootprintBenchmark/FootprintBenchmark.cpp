@@ -0,0 +1,183 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <EASTL/allocator.h>
+#include <EASTL/fixed_string.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "FootprintReport.h"
+#include "PackedNamePool.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	RecordEastlAllocation(size);
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	RecordEastlAllocation(size);
+	return new uint8_t[size];
+}
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// Large enough for every generated name, so the fixed strings never overflow to the heap.
+constexpr size_t FIXED_NAME_CAPACITY = 48;
+
+size_t MakeName(size_t index, char* buffer, size_t capacity)
+{
+    int length = snprintf(buffer, capacity, "%s%zu %s of Springfield", FIRST_NAMES[index % 10], index, SURNAMES[(index / 10) % 10]);
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+// Each name copied into its own null terminated allocation.
+class CStringCorpus
+{
+public:
+    ~CStringCorpus()
+    {
+        for (const char* name : mNames)
+        {
+            mAllocator.deallocate(const_cast<char*>(name), strlen(name) + 1);
+        }
+    }
+
+    void Add(const char* name, size_t length)
+    {
+        char* copy = static_cast<char*>(mAllocator.allocate(length + 1));
+        memcpy(copy, name, length + 1);
+        mNames.push_back(copy);
+    }
+
+    void Reserve(size_t count) { mNames.reserve(count); }
+
+private:
+    eastl::allocator mAllocator;
+    eastl::vector<const char*> mNames;
+};
+
+template <typename String>
+class StringCorpus
+{
+public:
+    void Add(const char* name, size_t length) { mNames.push_back(String(name, length)); }
+    void Reserve(size_t count) { mNames.reserve(count); }
+
+private:
+    eastl::vector<String> mNames;
+};
+
+// Hands out pool memory in 1MB chunks taken through the EASTL allocator, so the hook sees them.
+class ChunkArena
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+    ~ChunkArena()
+    {
+        for (char* chunk : mChunks)
+        {
+            mAllocator.deallocate(chunk, CHUNK_SIZE);
+        }
+    }
+
+    void* Allocate(size_t size, size_t alignment)
+    {
+        size_t offset = (mUsed + alignment - 1) & ~(alignment - 1);
+        if (mChunks.empty() || offset + size > CHUNK_SIZE)
+        {
+            mChunks.push_back(static_cast<char*>(mAllocator.allocate(CHUNK_SIZE)));
+            offset = 0;
+        }
+
+        mUsed = offset + size;
+        return mChunks.back() + offset;
+    }
+
+private:
+    eastl::allocator mAllocator;
+    eastl::vector<char*> mChunks;
+    size_t mUsed = 0;
+};
+
+// Names packed back to back in a pool, referenced by string_views.
+class PooledViewCorpus
+{
+public:
+    PooledViewCorpus() : mPool(mArena) {}
+
+    void Add(const char* name, size_t length) { mViews.push_back(mPool.Append(eastl::string_view(name, length))); }
+    void Reserve(size_t count) { mViews.reserve(count); }
+
+private:
+    ChunkArena mArena;
+    PackedNamePool<ChunkArena> mPool;
+    eastl::vector<eastl::string_view> mViews;
+};
+
+template <typename Corpus>
+void BuildAndReport(const char* label, size_t nameCount)
+{
+    char name[64];
+    Corpus corpus;
+
+    FootprintSample before = TakeFootprintSample();
+    corpus.Reserve(nameCount);
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        corpus.Add(name, MakeName(i, name, sizeof(name)));
+    }
+    FootprintSample after = TakeFootprintSample();
+
+    PrintFootprint(label, before, after, nameCount);
+}
+
+// Each representation is measured in a fresh child process where possible, so that memory kept
+// by the C heap after one corpus is freed does not hide the cost of the next.
+template <typename Corpus>
+void Measure(const char* label, size_t nameCount)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0)
+    {
+        BuildAndReport<Corpus>(label, nameCount);
+        fflush(stdout);
+        _exit(0);
+    }
+    else if (child > 0)
+    {
+        int status = 0;
+        waitpid(child, &status, 0);
+        return;
+    }
+#endif
+    BuildAndReport<Corpus>(label, nameCount);
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    if (nameCount == 0)
+    {
+        printf("Usage: FootprintBenchmark [nameCount]\n");
+        return 1;
+    }
+
+    printf("%zu names, deltas measured around building each corpus\n", nameCount);
+    PrintFootprintHeader();
+    Measure<CStringCorpus>("const char*", nameCount);
+    Measure<StringCorpus<eastl::string>>("eastl::string", nameCount);
+    Measure<PooledViewCorpus>("eastl::string_view + pool", nameCount);
+    Measure<StringCorpus<eastl::fixed_string<char, FIXED_NAME_CAPACITY, false>>>("eastl::fixed_string<48>", nameCount);
+
+    return 0;
+}
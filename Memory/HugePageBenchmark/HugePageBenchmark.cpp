@@ -0,0 +1,204 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "HugePageAllocator.h"
+#include "PackedNamePool.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// Counts data TLB read misses for the calling thread where perf events are available.
+class TlbMissCounter
+{
+public:
+    TlbMissCounter()
+    {
+#if defined(__linux__)
+        perf_event_attr attr = {};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        mFile = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~TlbMissCounter()
+    {
+#if defined(__linux__)
+        if (mFile >= 0)
+        {
+            close(mFile);
+        }
+#endif
+    }
+
+    bool IsAvailable() const { return mFile >= 0; }
+
+    void Start()
+    {
+#if defined(__linux__)
+        if (mFile >= 0)
+        {
+            ioctl(mFile, PERF_EVENT_IOC_RESET, 0);
+            ioctl(mFile, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    uint64_t Stop()
+    {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (mFile >= 0)
+        {
+            ioctl(mFile, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(mFile, &count, sizeof(count)) != sizeof(count))
+            {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+private:
+    int mFile = -1;
+};
+
+// Transparent huge page coverage of the whole process, in kB.
+size_t ReadAnonHugePagesKb()
+{
+    size_t total = 0;
+#if defined(__linux__)
+    FILE* file = fopen("/proc/self/smaps_rollup", "r");
+    if (file != nullptr)
+    {
+        char line[256];
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            size_t kb = 0;
+            if (sscanf(line, "AnonHugePages: %zu kB", &kb) == 1)
+            {
+                total += kb;
+            }
+        }
+        fclose(file);
+    }
+#endif
+    return total;
+}
+
+uint64_t NextRandom(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+const char* GetModeName(HugePageMode mode)
+{
+    switch (mode)
+    {
+    case HugePageMode::None: return "4KB pages";
+    case HugePageMode::Transparent: return "transparent huge pages";
+    default: return "explicit huge pages";
+    }
+}
+
+void RunBenchmark(HugePageMode mode, size_t nameCount, size_t lookupCount)
+{
+    size_t hugePagesBeforeKb = ReadAnonHugePagesKb();
+
+    HugePageArena arena(mode);
+    PackedNamePool<HugePageArena> pool(arena);
+    HugePageAllocator allocator(&arena);
+    eastl::vector<eastl::string_view, HugePageAllocator> names(allocator);
+    names.reserve(nameCount);
+
+    char name[64];
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        int length = snprintf(name, sizeof(name), "%s%zu %s", FIRST_NAMES[i % 10], i, SURNAMES[(i / 10) % 10]);
+        names.push_back(pool.Append(eastl::string_view(name, static_cast<size_t>(length))));
+    }
+
+    // PrankMoe's first name split over names picked at random, so nearly every access lands on a
+    // different page.
+    TlbMissCounter tlbMisses;
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    size_t checksum = 0;
+
+    tlbMisses.Start();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookupCount; ++i)
+    {
+        eastl::string_view fullName = names[NextRandom(state) % nameCount];
+        size_t delimiterPosition = fullName.find(' ');
+        checksum += delimiterPosition != eastl::string_view::npos ? delimiterPosition : fullName.length();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t misses = tlbMisses.Stop();
+
+    // A first name kept the way PrankMoe would keep it, as a string in the same arena.
+    eastl::string_view sampleName = names[NextRandom(state) % nameCount];
+    size_t sampleDelimiter = sampleName.find(' ');
+    HugePageString firstName(sampleName.data(), sampleDelimiter != eastl::string_view::npos ? sampleDelimiter : sampleName.length(), allocator);
+
+    double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    size_t hugePagesKb = ReadAnonHugePagesKb();
+
+    printf("%-24s %8.2f ns/lookup", GetModeName(mode), nanoseconds / static_cast<double>(lookupCount));
+    if (tlbMisses.IsAvailable())
+    {
+        printf("  %6.3f dTLB misses/lookup", static_cast<double>(misses) / static_cast<double>(lookupCount));
+    }
+    else
+    {
+        printf("  dTLB misses unavailable");
+    }
+    printf("  %6zu MB reserved  %6zu MB hugetlb  %6zu MB THP  (checksum %zu, eg. %s)\n",
+        arena.GetReservedBytes() >> 20, arena.GetExplicitHugePageBytes() >> 20,
+        (hugePagesKb > hugePagesBeforeKb ? hugePagesKb - hugePagesBeforeKb : 0) >> 10, checksum, firstName.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t lookupCount = argc > 2 ? strtoull(argv[2], nullptr, 10) : 20000000;
+    if (nameCount == 0 || lookupCount == 0)
+    {
+        printf("Usage: HugePageBenchmark [nameCount] [lookupCount]\n");
+        return 1;
+    }
+
+    printf("%zu names, %zu random lookups\n", nameCount, lookupCount);
+    RunBenchmark(HugePageMode::None, nameCount, lookupCount);
+    RunBenchmark(HugePageMode::Transparent, nameCount, lookupCount);
+    RunBenchmark(HugePageMode::Explicit, nameCount, lookupCount);
+
+    return 0;
+}
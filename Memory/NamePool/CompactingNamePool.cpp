@@ -0,0 +1,228 @@
+#include "CompactingNamePool.h"
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+    constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+}
+
+CompactingNamePool::~CompactingNamePool()
+{
+    for (Segment* segment : mSegments)
+    {
+        delete segment;
+    }
+
+    for (std::atomic<Entry*>& chunk : mEntryChunks)
+    {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+NameHandle CompactingNamePool::Add(eastl::string_view name)
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+
+    uint32_t index = INVALID_INDEX;
+    if (name.length() > UINT32_MAX || !AllocateEntry(index))
+    {
+        return { INVALID_INDEX, 0 };
+    }
+
+    Entry* entry = FindEntry(index);
+    const Record* record = AppendRecord(index, name, entry->segment);
+    entry->record.store(record, std::memory_order_release);
+
+    ++mNameCount;
+    mLiveBytes += name.length();
+    return { index, entry->generation.load(std::memory_order_relaxed) };
+}
+
+bool CompactingNamePool::Remove(NameHandle handle)
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+
+    Entry* entry = FindEntry(handle.index);
+    if (entry == nullptr || entry->generation.load(std::memory_order_relaxed) != handle.generation)
+    {
+        return false;
+    }
+
+    const Record* record = entry->record.load(std::memory_order_relaxed);
+    if (record == nullptr)
+    {
+        return false;
+    }
+
+    entry->segment->liveBytes -= GetRecordSize(record->length);
+    mLiveBytes -= record->length;
+    --mNameCount;
+
+    // The bytes stay where they are, so readers that already hold a view keep valid memory until
+    // the segment is compacted and their pins are gone.
+    entry->record.store(nullptr, std::memory_order_release);
+    entry->generation.store(handle.generation + 1, std::memory_order_release);
+    entry->segment = nullptr;
+    entry->nextFree = mFreeHead;
+    mFreeHead = handle.index;
+    return true;
+}
+
+eastl::string_view CompactingNamePool::Get(NameHandle handle) const
+{
+    Entry* entry = FindEntry(handle.index);
+    if (entry == nullptr || entry->generation.load(std::memory_order_acquire) != handle.generation)
+    {
+        return eastl::string_view();
+    }
+
+    const Record* record = entry->record.load(std::memory_order_acquire);
+
+    // A slot is only reused after its generation has moved on, so seeing the same generation
+    // again means 'record' still belongs to this handle.
+    if (record == nullptr || entry->generation.load(std::memory_order_relaxed) != handle.generation)
+    {
+        return eastl::string_view();
+    }
+
+    return eastl::string_view(record->GetData(), record->length);
+}
+
+size_t CompactingNamePool::Compact(float maxLiveRatio)
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+
+    eastl::vector<Segment*> sparse;
+    size_t kept = 0;
+    for (Segment* segment : mSegments)
+    {
+        if (segment != mActiveSegment && static_cast<float>(segment->liveBytes) < static_cast<float>(segment->used) * maxLiveRatio)
+        {
+            sparse.push_back(segment);
+        }
+        else
+        {
+            mSegments[kept++] = segment;
+        }
+    }
+    mSegments.resize(kept);
+
+    size_t released = 0;
+    for (Segment* segment : sparse)
+    {
+        size_t offset = 0;
+        while (offset < segment->used)
+        {
+            const Record* record = reinterpret_cast<const Record*>(segment->bytes + offset);
+            offset += GetRecordSize(record->length);
+
+            // A record is live only if its entry still points at it; a removed name's slot may
+            // have been reused by a name stored elsewhere.
+            Entry* entry = FindEntry(record->index);
+            if (entry->segment != segment || entry->record.load(std::memory_order_relaxed) != record)
+            {
+                continue;
+            }
+
+            const Record* moved = AppendRecord(record->index, eastl::string_view(record->GetData(), record->length), entry->segment);
+            entry->record.store(moved, std::memory_order_release);
+        }
+
+        mReservedBytes -= segment->capacity;
+        released += segment->capacity;
+        mEpochs.Retire(segment);
+    }
+
+    mEpochs.Collect();
+    return released;
+}
+
+size_t CompactingNamePool::GetCount() const
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    return mNameCount;
+}
+
+size_t CompactingNamePool::GetLiveBytes() const
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    return mLiveBytes;
+}
+
+size_t CompactingNamePool::GetReservedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    return mReservedBytes;
+}
+
+size_t CompactingNamePool::GetRecordSize(size_t length)
+{
+    return (sizeof(Record) + length + alignof(Record) - 1) & ~(alignof(Record) - 1);
+}
+
+CompactingNamePool::Entry* CompactingNamePool::FindEntry(uint32_t index) const
+{
+    size_t chunkIndex = index / ENTRY_CHUNK_SIZE;
+    if (chunkIndex >= MAX_ENTRY_CHUNKS)
+    {
+        return nullptr;
+    }
+
+    Entry* chunk = mEntryChunks[chunkIndex].load(std::memory_order_acquire);
+    return chunk != nullptr ? &chunk[index % ENTRY_CHUNK_SIZE] : nullptr;
+}
+
+bool CompactingNamePool::AllocateEntry(uint32_t& index)
+{
+    if (mFreeHead != INVALID_INDEX)
+    {
+        index = mFreeHead;
+        mFreeHead = FindEntry(index)->nextFree;
+        return true;
+    }
+
+    size_t chunkIndex = mEntryCount / ENTRY_CHUNK_SIZE;
+    if (chunkIndex >= MAX_ENTRY_CHUNKS)
+    {
+        return false;
+    }
+
+    if (mEntryCount % ENTRY_CHUNK_SIZE == 0)
+    {
+        Entry* chunk = new (std::nothrow) Entry[ENTRY_CHUNK_SIZE];
+        if (chunk == nullptr)
+        {
+            return false;
+        }
+        mEntryChunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    index = mEntryCount++;
+    return true;
+}
+
+const CompactingNamePool::Record* CompactingNamePool::AppendRecord(uint32_t index, eastl::string_view name, Segment*& segment)
+{
+    size_t size = GetRecordSize(name.length());
+    if (mActiveSegment == nullptr || mActiveSegment->used + size > mActiveSegment->capacity)
+    {
+        mActiveSegment = new Segment(size > SEGMENT_SIZE ? size : SEGMENT_SIZE);
+        mSegments.push_back(mActiveSegment);
+        mReservedBytes += mActiveSegment->capacity;
+    }
+
+    Record* record = reinterpret_cast<Record*>(mActiveSegment->bytes + mActiveSegment->used);
+    record->index = index;
+    record->length = static_cast<uint32_t>(name.length());
+    if (name.length() > 0)
+    {
+        memcpy(record + 1, name.data(), name.length());
+    }
+
+    mActiveSegment->used += size;
+    mActiveSegment->liveBytes += size;
+    segment = mActiveSegment;
+    return record;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "EpochDomain.h"
+
+// Identifies a name in a CompactingNamePool. A handle stays valid across compactions and is
+// rejected once its name has been removed, even if the slot has been reused since.
+struct NameHandle
+{
+    uint32_t index;
+    uint32_t generation;
+};
+
+// A name pool for long running processes that add and remove names continuously. Names are
+// packed into segments like an append-only pool, but removed names leave dead bytes behind that
+// Compact() reclaims by moving the live names out of sparse segments.
+//
+// Handles point into an indirection table rather than at the bytes, so moving a name only swings
+// one pointer. Readers pin the pool and read names without locks; a segment that has been
+// compacted away is retired to an epoch domain and freed once every reader pinned before the
+// move has unpinned. Adds, removals and compaction are serialized by a mutex.
+class CompactingNamePool
+{
+public:
+    static constexpr size_t SEGMENT_SIZE = 256 * 1024;
+    static constexpr size_t ENTRY_CHUNK_SIZE = 16384;
+    static constexpr size_t MAX_ENTRY_CHUNKS = 16384;
+
+    CompactingNamePool() = default;
+    ~CompactingNamePool();
+
+    CompactingNamePool(const CompactingNamePool&) = delete;
+    CompactingNamePool& operator=(const CompactingNamePool&) = delete;
+
+    // Returns a handle with index UINT32_MAX if the pool is full.
+    NameHandle Add(eastl::string_view name);
+
+    // Returns false if the handle has already been removed.
+    bool Remove(NameHandle handle);
+
+    // Views returned by Get() remain valid until the guard is destroyed.
+    EpochDomain::Guard Pin() { return EpochDomain::Guard(mEpochs); }
+
+    // Must be called while pinned. Returns an empty view for a removed handle.
+    eastl::string_view Get(NameHandle handle) const;
+
+    // Moves the live names out of every segment that is less than 'maxLiveRatio' live and
+    // retires those segments. Returns the number of segment bytes released.
+    size_t Compact(float maxLiveRatio = 0.5f);
+
+    size_t GetCount() const;
+    size_t GetLiveBytes() const;
+    size_t GetReservedBytes() const;
+
+private:
+    struct Record
+    {
+        uint32_t index;
+        uint32_t length;
+
+        const char* GetData() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    struct Segment
+    {
+        explicit Segment(size_t size) : bytes(new char[size]), capacity(size) {}
+        ~Segment() { delete[] bytes; }
+
+        char* bytes;
+        size_t capacity;
+        size_t used = 0;
+        size_t liveBytes = 0;
+    };
+
+    struct Entry
+    {
+        std::atomic<const Record*> record{ nullptr };
+        std::atomic<uint32_t> generation{ 0 };
+
+        // Only touched by writers.
+        Segment* segment = nullptr;
+        uint32_t nextFree = 0;
+    };
+
+    static size_t GetRecordSize(size_t length);
+
+    Entry* FindEntry(uint32_t index) const;
+    bool AllocateEntry(uint32_t& index);
+    const Record* AppendRecord(uint32_t index, eastl::string_view name, Segment*& segment);
+
+    EpochDomain mEpochs;
+
+    // Fixed directory of entry chunks, so the table grows without moving entries under readers.
+    std::atomic<Entry*> mEntryChunks[MAX_ENTRY_CHUNKS] = {};
+
+    mutable std::mutex mWriterMutex;
+    eastl::vector<Segment*> mSegments;
+    Segment* mActiveSegment = nullptr;
+    uint32_t mEntryCount = 0;
+    uint32_t mFreeHead = UINT32_MAX;
+    size_t mNameCount = 0;
+    size_t mLiveBytes = 0;
+    size_t mReservedBytes = 0;
+};
@@ -0,0 +1,74 @@
+#include "CompressedNamePool.h"
+
+#include "EncodingUtilities.h"
+
+uint32_t CompressedNamePool::Append(eastl::string_view name)
+{
+    if (mCount % INDEX_STRIDE == 0)
+    {
+        mIndex.push_back(mData.size());
+    }
+
+    mCodes.clear();
+    mSymbols.Encode(name, mCodes);
+    WriteVarint(mData, mCodes.size());
+    mData.insert(mData.end(), mCodes.begin(), mCodes.end());
+    return static_cast<uint32_t>(mCount++);
+}
+
+size_t CompressedNamePool::Decode(uint32_t id, char* buffer, size_t capacity) const
+{
+    size_t count;
+    const uint8_t* codes = GetCodes(id, count);
+    return codes != nullptr ? mSymbols.Decode(codes, count, buffer, capacity) : 0;
+}
+
+size_t CompressedNamePool::DecodeFirstName(uint32_t id, char* buffer, size_t capacity) const
+{
+    size_t count;
+    const uint8_t* codes = GetCodes(id, count);
+    if (codes == nullptr)
+    {
+        return npos;
+    }
+
+    // The codes up to the delimiter's cover the first name and a little more.
+    size_t codeCount;
+    size_t length = mSymbols.FindDelimiter(codes, count, codeCount);
+    if (length != npos)
+    {
+        mSymbols.Decode(codes, codeCount, buffer, capacity);
+    }
+    return length;
+}
+
+size_t CompressedNamePool::GetFirstNameLength(uint32_t id) const
+{
+    size_t count;
+    const uint8_t* codes = GetCodes(id, count);
+    if (codes == nullptr)
+    {
+        return npos;
+    }
+
+    size_t codeCount;
+    return mSymbols.FindDelimiter(codes, count, codeCount);
+}
+
+const uint8_t* CompressedNamePool::GetCodes(uint32_t id, size_t& count) const
+{
+    if (id >= mCount)
+    {
+        count = 0;
+        return nullptr;
+    }
+
+    size_t offset = static_cast<size_t>(mIndex[id / INDEX_STRIDE]);
+    for (size_t skip = id % INDEX_STRIDE; skip > 0; --skip)
+    {
+        offset += ReadVarint(mData.data(), offset);
+    }
+
+    count = ReadVarint(mData.data(), offset);
+    return mData.data() + offset;
+}
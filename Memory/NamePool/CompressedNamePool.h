@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "SymbolTable.h"
+
+// An append-only name pool that stores every name compressed with a trained SymbolTable. Each
+// name is stored as its code count followed by its codes, and the offset of every INDEX_STRIDE-th
+// name is indexed, so any name can be reached by skipping at most INDEX_STRIDE - 1 short records
+// and decoded on its own.
+//
+// For names like "Homer Sexual" most symbols are whole syllables or words, so a name often takes
+// a quarter to a third of its length, plus about half a byte of index.
+class CompressedNamePool
+{
+public:
+    static constexpr size_t INDEX_STRIDE = 16;
+    static constexpr size_t npos = eastl::string_view::npos;
+
+    explicit CompressedNamePool(const SymbolTable& symbols) : mSymbols(symbols) {}
+
+    // Returns the new name's id. Ids are assigned in order from 0.
+    uint32_t Append(eastl::string_view name);
+
+    // Writes up to 'capacity' bytes of the name to 'buffer' and returns its full length.
+    size_t Decode(uint32_t id, char* buffer, size_t capacity) const;
+
+    // Decodes only as far as the first delimiter and returns the first name's length, or npos if
+    // the name has no delimiter. Names without one are not decoded at all.
+    size_t DecodeFirstName(uint32_t id, char* buffer, size_t capacity) const;
+
+    // Length of the first name, found from the codes without decoding anything.
+    size_t GetFirstNameLength(uint32_t id) const;
+
+    size_t GetCount() const { return mCount; }
+    size_t GetCompressedBytes() const { return mData.size() + mIndex.size() * sizeof(uint64_t); }
+
+private:
+    const uint8_t* GetCodes(uint32_t id, size_t& count) const;
+
+    SymbolTable mSymbols;
+    eastl::vector<uint8_t> mData;
+    eastl::vector<uint64_t> mIndex;
+    eastl::vector<uint8_t> mCodes;
+    size_t mCount = 0;
+};
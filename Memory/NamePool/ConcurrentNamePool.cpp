@@ -0,0 +1,116 @@
+#include "ConcurrentNamePool.h"
+
+#include <cstring>
+#include <new>
+
+eastl::string_view ConcurrentNamePool::Appender::Append(eastl::string_view name)
+{
+    char* storage = nullptr;
+    if (name.length() > CHUNK_SIZE)
+    {
+        storage = mPool.AllocateLarge(name.length());
+    }
+    else
+    {
+        if (static_cast<size_t>(mEnd - mCursor) < name.length())
+        {
+            // The rest of the current chunk is abandoned.
+            char* chunk = mPool.ClaimChunk();
+            if (chunk == nullptr)
+            {
+                return eastl::string_view();
+            }
+            mCursor = chunk;
+            mEnd = chunk + CHUNK_SIZE;
+        }
+
+        storage = mCursor;
+        mCursor += name.length();
+    }
+
+    if (storage == nullptr)
+    {
+        return eastl::string_view();
+    }
+
+    if (name.length() > 0)
+    {
+        memcpy(storage, name.data(), name.length());
+    }
+    return eastl::string_view(storage, name.length());
+}
+
+ConcurrentNamePool::~ConcurrentNamePool()
+{
+    Reset();
+    for (std::atomic<char*>& block : mBlocks)
+    {
+        delete[] block.load(std::memory_order_relaxed);
+    }
+}
+
+void ConcurrentNamePool::Reset()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (char* name : mLargeNames)
+    {
+        delete[] name;
+    }
+    mLargeNames.clear();
+    mClaimed.store(0, std::memory_order_relaxed);
+}
+
+size_t ConcurrentNamePool::GetClaimedBytes() const
+{
+    uint64_t claimed = mClaimed.load(std::memory_order_relaxed);
+    uint64_t limit = static_cast<uint64_t>(MAX_BLOCKS) * BLOCK_SIZE;
+    return static_cast<size_t>(claimed < limit ? claimed : limit);
+}
+
+size_t ConcurrentNamePool::GetReservedBytes() const
+{
+    return mBlockCount.load(std::memory_order_relaxed) * BLOCK_SIZE;
+}
+
+char* ConcurrentNamePool::ClaimChunk()
+{
+    // Chunks divide blocks evenly, so a chunk never straddles two blocks.
+    uint64_t offset = mClaimed.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+    size_t blockIndex = static_cast<size_t>(offset / BLOCK_SIZE);
+    if (blockIndex >= MAX_BLOCKS)
+    {
+        return nullptr;
+    }
+
+    char* block = mBlocks[blockIndex].load(std::memory_order_acquire);
+    if (block == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        block = mBlocks[blockIndex].load(std::memory_order_relaxed);
+        if (block == nullptr)
+        {
+            block = new (std::nothrow) char[BLOCK_SIZE];
+            if (block == nullptr)
+            {
+                return nullptr;
+            }
+            mBlocks[blockIndex].store(block, std::memory_order_release);
+            mBlockCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    return block + offset % BLOCK_SIZE;
+}
+
+char* ConcurrentNamePool::AllocateLarge(size_t size)
+{
+    char* name = new (std::nothrow) char[size];
+    if (name == nullptr)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mLargeNames.push_back(name);
+    return name;
+}
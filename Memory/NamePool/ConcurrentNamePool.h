@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+// An append-only name pool that many threads fill at once. Each thread appends through its own
+// Appender, which claims 64KB chunks from the pool with a single atomic add and then packs names
+// into them with no synchronization at all. The views it returns stay valid, and can be read from
+// any thread, until Reset().
+//
+// Memory comes from 16MB blocks that are never moved, so a claimed chunk is stable. The only lock
+// is taken by the first thread to claim a chunk in a block that has not been allocated yet.
+class ConcurrentNamePool
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+    static constexpr size_t BLOCK_SIZE = 16 * 1024 * 1024;
+    static constexpr size_t MAX_BLOCKS = 4096;
+
+    // One per appending thread. Must not be used after the pool is reset.
+    class Appender
+    {
+    public:
+        explicit Appender(ConcurrentNamePool& pool) : mPool(pool) {}
+
+        Appender(const Appender&) = delete;
+        Appender& operator=(const Appender&) = delete;
+
+        // Returns an empty view if the pool is full.
+        eastl::string_view Append(eastl::string_view name);
+
+    private:
+        ConcurrentNamePool& mPool;
+        char* mCursor = nullptr;
+        char* mEnd = nullptr;
+    };
+
+    ConcurrentNamePool() = default;
+    ~ConcurrentNamePool();
+
+    ConcurrentNamePool(const ConcurrentNamePool&) = delete;
+    ConcurrentNamePool& operator=(const ConcurrentNamePool&) = delete;
+
+    // Invalidates every view and appender. Blocks are kept for reuse. Must not run concurrently
+    // with appends or reads.
+    void Reset();
+
+    size_t GetClaimedBytes() const;
+    size_t GetReservedBytes() const;
+
+private:
+    char* ClaimChunk();
+    char* AllocateLarge(size_t size);
+
+    std::atomic<uint64_t> mClaimed{ 0 };
+    std::atomic<char*> mBlocks[MAX_BLOCKS] = {};
+    std::atomic<size_t> mBlockCount{ 0 };
+
+    // Allocating blocks, and names too large for a chunk.
+    std::mutex mMutex;
+    eastl::vector<char*> mLargeNames;
+};
@@ -0,0 +1,192 @@
+#include "SymbolTable.h"
+
+#include <cstring>
+#include <EASTL/hash_map.h>
+#include <EASTL/sort.h>
+#include <EASTL/utility.h>
+#include "EncodingUtilities.h"
+
+namespace
+{
+    constexpr size_t TRAINING_ROUNDS = 5;
+}
+
+SymbolTable::SymbolTable()
+{
+    SetSymbols(eastl::vector<eastl::string>());
+}
+
+void SymbolTable::Train(const eastl::vector<eastl::string_view>& sample, char delimiter)
+{
+    mDelimiter = delimiter;
+    SetSymbols(eastl::vector<eastl::string>());
+
+    eastl::vector<uint8_t> codes;
+    for (size_t round = 0; round < TRAINING_ROUNDS; ++round)
+    {
+        // Encode the sample with the current table. Every symbol it uses, escaped bytes included,
+        // is a candidate, and so is every pair of adjacent symbols that fits in 8 bytes.
+        eastl::hash_map<eastl::string, size_t> counts;
+        for (eastl::string_view text : sample)
+        {
+            codes.clear();
+            Encode(text, codes);
+
+            size_t position = 0;
+            size_t previousLength = 0;
+            for (size_t i = 0; i < codes.size(); ++i)
+            {
+                size_t length = codes[i] == ESCAPE ? 1 : mLengths[codes[i]];
+                i += codes[i] == ESCAPE ? 1 : 0;
+
+                ++counts[eastl::string(text.data() + position, length)];
+                if (previousLength != 0 && previousLength + length <= MAX_SYMBOL_LENGTH)
+                {
+                    ++counts[eastl::string(text.data() + position - previousLength, previousLength + length)];
+                }
+
+                position += length;
+                previousLength = length;
+            }
+        }
+
+        // An occurrence of a symbol of length L saves 2L - 1 bytes over escaping each byte.
+        eastl::vector<eastl::pair<size_t, eastl::string>> candidates;
+        candidates.reserve(counts.size());
+        for (const auto& count : counts)
+        {
+            candidates.push_back(eastl::make_pair(count.second * (2 * count.first.length() - 1), count.first));
+        }
+        eastl::sort(candidates.begin(), candidates.end(),
+            [](const eastl::pair<size_t, eastl::string>& a, const eastl::pair<size_t, eastl::string>& b)
+            {
+                return a.first != b.first ? a.first > b.first : a.second < b.second;
+            });
+
+        eastl::vector<eastl::string> symbols;
+        for (size_t i = 0; i < candidates.size() && i < MAX_SYMBOLS; ++i)
+        {
+            symbols.push_back(candidates[i].second);
+        }
+        SetSymbols(symbols);
+    }
+}
+
+void SymbolTable::Encode(eastl::string_view text, eastl::vector<uint8_t>& codes) const
+{
+    size_t position = 0;
+    while (position < text.length())
+    {
+        // Greedy: the longest symbol that matches here, or an escaped byte.
+        size_t remaining = text.length() - position;
+        bool matched = false;
+        for (uint8_t code : mCodesByFirstByte[static_cast<uint8_t>(text[position])])
+        {
+            size_t length = mLengths[code];
+            if (length <= remaining && memcmp(&mSymbols[code], text.data() + position, length) == 0)
+            {
+                codes.push_back(code);
+                position += length;
+                matched = true;
+                break;
+            }
+        }
+
+        if (!matched)
+        {
+            codes.push_back(ESCAPE);
+            codes.push_back(static_cast<uint8_t>(text[position]));
+            ++position;
+        }
+    }
+}
+
+size_t SymbolTable::Decode(const uint8_t* codes, size_t count, char* buffer, size_t capacity) const
+{
+    size_t length = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint8_t code = codes[i];
+        if (code == ESCAPE)
+        {
+            if (++i < count && length < capacity)
+            {
+                buffer[length] = static_cast<char>(codes[i]);
+            }
+            ++length;
+        }
+        else if (length + MAX_SYMBOL_LENGTH <= capacity)
+        {
+            // Copying a whole word and advancing by the symbol's length avoids a loop per symbol.
+            memcpy(buffer + length, &mSymbols[code], MAX_SYMBOL_LENGTH);
+            length += mLengths[code];
+        }
+        else
+        {
+            CopyClamped(buffer, capacity, length, &mSymbols[code], mLengths[code]);
+            length += mLengths[code];
+        }
+    }
+    return length;
+}
+
+size_t SymbolTable::FindDelimiter(const uint8_t* codes, size_t count, size_t& codeCount) const
+{
+    size_t position = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint8_t code = codes[i];
+        if (code == ESCAPE)
+        {
+            if (++i < count && static_cast<char>(codes[i]) == mDelimiter)
+            {
+                codeCount = i + 1;
+                return position;
+            }
+            ++position;
+        }
+        else if (mDelimiterOffsets[code] < MAX_SYMBOL_LENGTH)
+        {
+            codeCount = i + 1;
+            return position + mDelimiterOffsets[code];
+        }
+        else
+        {
+            position += mLengths[code];
+        }
+    }
+
+    codeCount = count;
+    return npos;
+}
+
+void SymbolTable::SetSymbols(const eastl::vector<eastl::string>& symbols)
+{
+    memset(mSymbols, 0, sizeof(mSymbols));
+    memset(mLengths, 0, sizeof(mLengths));
+    memset(mDelimiterOffsets, MAX_SYMBOL_LENGTH, sizeof(mDelimiterOffsets));
+    for (eastl::vector<uint8_t>& codes : mCodesByFirstByte)
+    {
+        codes.clear();
+    }
+
+    mSymbolCount = symbols.size() < MAX_SYMBOLS ? symbols.size() : MAX_SYMBOLS;
+    for (size_t code = 0; code < mSymbolCount; ++code)
+    {
+        const eastl::string& symbol = symbols[code];
+        memcpy(&mSymbols[code], symbol.data(), symbol.length());
+        mLengths[code] = static_cast<uint8_t>(symbol.length());
+
+        size_t delimiterOffset = symbol.find(mDelimiter);
+        if (delimiterOffset != eastl::string::npos)
+        {
+            mDelimiterOffsets[code] = static_cast<uint8_t>(delimiterOffset);
+        }
+        mCodesByFirstByte[static_cast<uint8_t>(symbol[0])].push_back(static_cast<uint8_t>(code));
+    }
+
+    for (eastl::vector<uint8_t>& codes : mCodesByFirstByte)
+    {
+        eastl::sort(codes.begin(), codes.end(), [this](uint8_t a, uint8_t b) { return mLengths[a] > mLengths[b]; });
+    }
+}
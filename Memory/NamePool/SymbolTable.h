@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+// A static table of up to 255 symbols, each 1 to 8 bytes long, that compresses short strings one
+// code byte per symbol in the style of FSST. Code 255 escapes a single literal byte. Strings are
+// compressed independently, so any one of them can be decoded without its neighbours.
+//
+// The table is trained on a sample of the strings it will compress. Training repeatedly encodes
+// the sample, counts how often each symbol and each pair of adjacent symbols occurs, and keeps the
+// 255 candidates that would save the most bytes.
+class SymbolTable
+{
+public:
+    static constexpr size_t MAX_SYMBOLS = 255;
+    static constexpr size_t MAX_SYMBOL_LENGTH = 8;
+    static constexpr uint8_t ESCAPE = 255;
+    static constexpr size_t npos = eastl::string_view::npos;
+
+    SymbolTable();
+
+    // Replaces the table with one trained on 'sample'. 'delimiter' is the character that
+    // FindDelimiter() looks for.
+    void Train(const eastl::vector<eastl::string_view>& sample, char delimiter = ' ');
+
+    // Appends the codes for 'text' to 'codes'.
+    void Encode(eastl::string_view text, eastl::vector<uint8_t>& codes) const;
+
+    // Writes up to 'capacity' bytes of the decoded text to 'buffer' and returns its full length.
+    size_t Decode(const uint8_t* codes, size_t count, char* buffer, size_t capacity) const;
+
+    // Position of the first delimiter in the decoded text, or npos, found from the codes alone.
+    // 'codeCount' is set to the number of codes that cover the text up to and including it.
+    size_t FindDelimiter(const uint8_t* codes, size_t count, size_t& codeCount) const;
+
+    size_t GetSymbolCount() const { return mSymbolCount; }
+
+private:
+    void SetSymbols(const eastl::vector<eastl::string>& symbols);
+
+    // Symbol bytes in memory order, so the decoder can copy all 8 and advance by the length.
+    uint64_t mSymbols[256];
+    uint8_t mLengths[256];
+    // Offset of the delimiter within each symbol, or MAX_SYMBOL_LENGTH if it has none.
+    uint8_t mDelimiterOffsets[256];
+    size_t mSymbolCount = 0;
+    char mDelimiter = ' ';
+
+    // Codes of the symbols that start with each byte, longest symbol first.
+    eastl::vector<uint8_t> mCodesByFirstByte[256];
+};
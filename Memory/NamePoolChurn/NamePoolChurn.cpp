@@ -0,0 +1,163 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+#include "CompactingNamePool.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+constexpr size_t COMPACT_INTERVAL = 100000;
+
+size_t PrankMoe(const char* localised, eastl::string_view fullName, char* buffer, size_t capacity)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    size_t firstNameLength = delimiterPosition != eastl::string_view::npos ? delimiterPosition : fullName.length();
+
+    int length = snprintf(buffer, capacity, localised, static_cast<int>(firstNameLength), fullName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+uint64_t PackHandle(NameHandle handle)
+{
+    return (static_cast<uint64_t>(handle.generation) << 32) | handle.index;
+}
+
+NameHandle UnpackHandle(uint64_t packed)
+{
+    return { static_cast<uint32_t>(packed), static_cast<uint32_t>(packed >> 32) };
+}
+
+NameHandle AddName(CompactingNamePool& pool, size_t serial)
+{
+    char name[64];
+    int length = snprintf(name, sizeof(name), "%s%zu %s of Springfield", FIRST_NAMES[serial % 10], serial, SURNAMES[(serial / 10) % 10]);
+    return pool.Add(eastl::string_view(name, static_cast<size_t>(length)));
+}
+
+// A writer keeps replacing random names while readers prank whichever names are current. With
+// compaction off the pool only grows; with it on, reserved memory tracks the live set.
+void RunChurn(bool compact, size_t liveCount, size_t replacements, unsigned readerCount)
+{
+    CompactingNamePool pool;
+    eastl::unique_ptr<std::atomic<uint64_t>[]> slots(new std::atomic<uint64_t>[liveCount]);
+    for (size_t i = 0; i < liveCount; ++i)
+    {
+        slots[i].store(PackHandle(AddName(pool, i)), std::memory_order_relaxed);
+    }
+
+    std::atomic<bool> done{ false };
+    eastl::vector<std::thread> readers;
+    eastl::vector<size_t> pranks(readerCount, 0);
+    eastl::vector<size_t> misses(readerCount, 0);
+    for (unsigned r = 0; r < readerCount; ++r)
+    {
+        readers.push_back(std::thread([&, r]
+        {
+            char buffer[256];
+            uint64_t state = 0x9E3779B97F4A7C15ull * (r + 1);
+            while (!done.load(std::memory_order_relaxed))
+            {
+                EpochDomain::Guard guard = pool.Pin();
+                for (int i = 0; i < 256; ++i)
+                {
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+
+                    eastl::string_view fullName = pool.Get(UnpackHandle(slots[state % liveCount].load(std::memory_order_acquire)));
+                    if (fullName.empty())
+                    {
+                        // Replaced between loading the handle and reading it.
+                        ++misses[r];
+                        continue;
+                    }
+
+                    PrankMoe(MOE_DIALOGUE_1, fullName, buffer, sizeof(buffer));
+                    ++pranks[r];
+                }
+            }
+        }));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t peakReserved = 0;
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < replacements; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        std::atomic<uint64_t>& slot = slots[state % liveCount];
+        NameHandle replacement = AddName(pool, liveCount + i);
+        pool.Remove(UnpackHandle(slot.exchange(PackHandle(replacement), std::memory_order_acq_rel)));
+
+        if ((i + 1) % COMPACT_INTERVAL == 0)
+        {
+            size_t reserved = pool.GetReservedBytes();
+            peakReserved = reserved > peakReserved ? reserved : peakReserved;
+            if (compact)
+            {
+                pool.Compact();
+            }
+        }
+    }
+
+    done.store(true, std::memory_order_relaxed);
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double milliseconds = std::chrono::duration<double, std::milli>(elapsed).count();
+
+    size_t totalPranks = 0;
+    size_t totalMisses = 0;
+    for (unsigned r = 0; r < readerCount; ++r)
+    {
+        totalPranks += pranks[r];
+        totalMisses += misses[r];
+    }
+
+    printf("%-18s %9.1f ms  %7.1f ns/replacement  %zu pranks, %zu misses\n", compact ? "compaction on" : "compaction off",
+        milliseconds, milliseconds * 1e6 / static_cast<double>(replacements), totalPranks, totalMisses);
+    printf("%-18s live %zu KB, reserved %zu KB now, %zu KB at peak\n", "", pool.GetLiveBytes() / 1024,
+        pool.GetReservedBytes() / 1024, peakReserved / 1024);
+}
+
+int main(int argc, char** argv)
+{
+    size_t liveCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t replacements = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000000;
+    unsigned readerCount = argc > 3 ? static_cast<unsigned>(strtoul(argv[3], nullptr, 10)) : 3;
+    if (liveCount == 0 || replacements == 0)
+    {
+        printf("Usage: NamePoolChurn [liveNames] [replacements] [readerThreads]\n");
+        return 1;
+    }
+
+    printf("%zu live names, %zu replacements, %u reader threads\n", liveCount, replacements, readerCount);
+    RunChurn(false, liveCount, replacements, readerCount);
+    RunChurn(true, liveCount, replacements, readerCount);
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <EASTL/string.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+#include "ThreadArenaAllocator.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+constexpr size_t BATCH_SIZE = 256;
+constexpr size_t MAX_QUEUED_BATCHES = 64;
+
+// Hands batches of names from the reader thread to the formatter threads.
+template <typename String>
+class BatchQueue
+{
+public:
+    void Push(eastl::vector<String>&& batch)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotFull.wait(lock, [this] { return mBatches.size() < MAX_QUEUED_BATCHES; });
+        mBatches.push_back(eastl::move(batch));
+        mNotEmpty.notify_one();
+    }
+
+    bool Pop(eastl::vector<String>& batch)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotEmpty.wait(lock, [this] { return !mBatches.empty() || mClosed; });
+        if (mBatches.empty())
+        {
+            return false;
+        }
+
+        batch = eastl::move(mBatches.front());
+        mBatches.erase(mBatches.begin());
+        mNotFull.notify_one();
+        return true;
+    }
+
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+        mNotEmpty.notify_all();
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mNotEmpty;
+    std::condition_variable mNotFull;
+    eastl::vector<eastl::vector<String>> mBatches;
+    bool mClosed = false;
+};
+
+template <typename String>
+size_t PrankMoe(const char* localised, const String& fullName, char* buffer, size_t capacity)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    size_t firstNameLength = delimiterPosition != String::npos ? delimiterPosition : fullName.length();
+
+    int length = snprintf(buffer, capacity, localised, static_cast<int>(firstNameLength), fullName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+// The reader materializes every name as an owning string and the formatters release them, so
+// each string is allocated on one thread and freed on another.
+template <typename String>
+void RunPipeline(const char* label, size_t nameCount, unsigned formatterCount)
+{
+    BatchQueue<String> queue;
+    ThreadArena::Stats readerStats = {};
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread reader([&]
+    {
+        char name[64];
+        eastl::vector<String> batch;
+        for (size_t i = 0; i < nameCount; ++i)
+        {
+            int length = snprintf(name, sizeof(name), "%s%zu %s of Springfield", FIRST_NAMES[i % 10], i, SURNAMES[(i / 10) % 10]);
+            batch.push_back(String(name, static_cast<size_t>(length)));
+            if (batch.size() == BATCH_SIZE)
+            {
+                queue.Push(eastl::move(batch));
+                batch = eastl::vector<String>();
+            }
+        }
+        if (!batch.empty())
+        {
+            queue.Push(eastl::move(batch));
+        }
+        queue.Close();
+        readerStats = ThreadArena::Get().GetStats();
+    });
+
+    eastl::vector<std::thread> formatters;
+    eastl::vector<size_t> formattedBytes(formatterCount, 0);
+    for (unsigned f = 0; f < formatterCount; ++f)
+    {
+        formatters.push_back(std::thread([&queue, &formattedBytes, f]
+        {
+            char buffer[256];
+            size_t bytes = 0;
+            eastl::vector<String> batch;
+            while (queue.Pop(batch))
+            {
+                for (const String& fullName : batch)
+                {
+                    bytes += PrankMoe(MOE_DIALOGUE_1, fullName, buffer, sizeof(buffer));
+                }
+                batch.clear();
+            }
+            formattedBytes[f] = bytes;
+        }));
+    }
+
+    reader.join();
+    for (std::thread& formatter : formatters)
+    {
+        formatter.join();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double milliseconds = std::chrono::duration<double, std::milli>(elapsed).count();
+
+    size_t totalBytes = 0;
+    for (size_t bytes : formattedBytes)
+    {
+        totalBytes += bytes;
+    }
+
+    printf("%-32s %9.1f ms  %7.1f ns/name  %zu bytes formatted\n", label, milliseconds,
+        milliseconds * 1e6 / static_cast<double>(nameCount), totalBytes);
+    if (readerStats.allocations > 0)
+    {
+        printf("%-32s reader arena: %llu allocations, %llu remote frees drained, %zu KB of spans\n", "",
+            static_cast<unsigned long long>(readerStats.allocations),
+            static_cast<unsigned long long>(readerStats.remoteFreesReceived), readerStats.spanBytes / 1024);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000000;
+    unsigned formatterCount = argc > 2 ? static_cast<unsigned>(strtoul(argv[2], nullptr, 10)) : 3;
+    if (nameCount == 0 || formatterCount == 0)
+    {
+        printf("Usage: ThreadArenaPipeline [nameCount] [formatterThreads]\n");
+        return 1;
+    }
+
+    printf("%zu names, 1 reader thread, %u formatter threads\n", nameCount, formatterCount);
+    RunPipeline<eastl::string>("eastl::string (global new[])", nameCount, formatterCount);
+    RunPipeline<ThreadString>("ThreadString (thread arenas)", nameCount, formatterCount);
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "HeapProfiler.h"
+
+std::atomic<uint64_t> gAllocatedBytes{ 0 };
+
+void* operator new(size_t size)
+{
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    RecordHeapAllocation(memory, size);
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    RecordHeapFree(memory);
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    RecordHeapFree(memory);
+    free(memory);
+}
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// One in REGULAR_INTERVAL callers is a regular, whose name the bar keeps for the whole run.
+constexpr size_t REGULAR_INTERVAL = 16;
+
+// A generic helper that both the kept and the thrown away names go through. Counting allocations
+// by call site would put everything here; the stacks above it tell the two apart.
+eastl::string JoinName(size_t index)
+{
+    eastl::string name = FIRST_NAMES[index % 10];
+    name.append(eastl::to_string(index));
+    name.push_back(' ');
+    name.append(SURNAMES[(index / 10) % 10]);
+    name.append(" of Springfield");
+    return name;
+}
+
+size_t PrankMoe(const eastl::string& fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    eastl::string outputName = delimiterPosition != eastl::string::npos ? fullName.substr(0, delimiterPosition) : fullName;
+
+    eastl::string dialogue;
+    dialogue.resize(256);
+    int length = snprintf(&dialogue[0], dialogue.size(), MOE_DIALOGUE_1, static_cast<int>(outputName.length()), outputName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+void RememberRegular(eastl::vector<eastl::string>& regulars, size_t index)
+{
+    regulars.push_back(JoinName(index));
+}
+
+size_t TakeCall(size_t index)
+{
+    return PrankMoe(JoinName(index));
+}
+
+void TimeCalls(const char* label, size_t callCount, eastl::vector<eastl::string>& regulars)
+{
+    uint64_t allocatedBefore = gAllocatedBytes.load(std::memory_order_relaxed);
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < callCount; ++i)
+    {
+        bytes += TakeCall(i);
+        if (i % REGULAR_INTERVAL == 0)
+        {
+            RememberRegular(regulars, i);
+        }
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-44s %8.1f ms  %6.1f ns/call  (%zu bytes formatted, %.1f MB allocated)\n", label, nanoseconds / 1e6,
+        nanoseconds / static_cast<double>(callCount), bytes,
+        static_cast<double>(gAllocatedBytes.load(std::memory_order_relaxed) - allocatedBefore) / (1024.0 * 1024.0));
+}
+
+int main(int argc, char** argv)
+{
+    size_t callCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+    size_t sampleInterval = argc > 2 ? strtoull(argv[2], nullptr, 10) : DEFAULT_HEAP_SAMPLE_INTERVAL;
+    const char* outputPrefix = argc > 3 ? argv[3] : "PrankMoe";
+    if (callCount == 0 || sampleInterval == 0)
+    {
+        printf("Usage: HeapProfileBenchmark [calls] [sampleIntervalBytes] [outputPrefix]\n");
+        return 1;
+    }
+
+    {
+        eastl::vector<eastl::string> regulars;
+        TimeCalls("Profiler off", callCount, regulars);
+    }
+
+    if (!StartHeapProfiler(sampleInterval))
+    {
+        printf("Could not start the heap profiler\n");
+        return 1;
+    }
+
+    eastl::vector<eastl::string> regulars;
+    uint64_t allocatedBefore = gAllocatedBytes.load(std::memory_order_relaxed);
+    char label[64];
+    snprintf(label, sizeof(label), "Sampling every %zu bytes", sampleInterval);
+    TimeCalls(label, callCount, regulars);
+
+    HeapProfileSummary summary = GetHeapProfileSummary();
+    printf("%llu samples (%llu live, %llu dropped) over %u stacks\n", static_cast<unsigned long long>(summary.samples),
+        static_cast<unsigned long long>(summary.liveSamples), static_cast<unsigned long long>(summary.droppedSamples), summary.stackCount);
+    printf("Estimated %.1f MB allocated (actually %.1f MB) and %.1f MB live\n", summary.estimatedAllocatedBytes / (1024.0 * 1024.0),
+        static_cast<double>(gAllocatedBytes.load(std::memory_order_relaxed) - allocatedBefore) / (1024.0 * 1024.0),
+        summary.estimatedLiveBytes / (1024.0 * 1024.0));
+
+    eastl::string pprofPath = eastl::string(outputPrefix) + ".heap";
+    eastl::string livePath = eastl::string(outputPrefix) + ".live.folded";
+    eastl::string allocatedPath = eastl::string(outputPrefix) + ".alloc.folded";
+    bool written = WriteHeapProfile(pprofPath.c_str(), HeapProfileFormat::Pprof) &&
+        WriteHeapProfile(livePath.c_str(), HeapProfileFormat::Folded, HeapProfileView::LiveBytes) &&
+        WriteHeapProfile(allocatedPath.c_str(), HeapProfileFormat::Folded, HeapProfileView::AllocatedBytes);
+    printf(written ? "Wrote %s, %s and %s\n" : "Could not write %s, %s or %s\n", pprofPath.c_str(), livePath.c_str(), allocatedPath.c_str());
+
+    // A much shorter interval, to show how the cost grows with the sampling rate.
+    StartHeapProfiler(4096);
+    regulars.clear();
+    TimeCalls("Sampling every 4096 bytes", callCount, regulars);
+    StopHeapProfiler();
+    return written ? 0 : 1;
+}
@@ -0,0 +1,494 @@
+#include "HeapProfiler.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#define HEAP_PROFILER_USE_BACKTRACE 1
+#define HEAP_PROFILER_NOINLINE __attribute__((noinline))
+#else
+#define HEAP_PROFILER_NOINLINE
+#endif
+
+namespace
+{
+    constexpr uint32_t MAX_FRAMES = 32;
+    // SampleAllocation() and RecordHeapAllocation() are left off every stack.
+    constexpr int SKIPPED_FRAMES = 2;
+
+    constexpr size_t STACK_CAPACITY = 8192;
+    constexpr size_t LIVE_CAPACITY = 65536;
+    constexpr size_t FILTER_SIZE = 65536;
+    constexpr uint32_t NO_STACK = 0xFFFFFFFF;
+    constexpr uint8_t FILTER_SATURATED = 255;
+
+    struct StackRecord
+    {
+        bool used;
+        uint32_t depth;
+        uint64_t hash;
+        void* frames[MAX_FRAMES];
+        // Estimates for the whole heap, from weighted samples.
+        double allocatedCount;
+        double allocatedBytes;
+        double freedCount;
+        double freedBytes;
+    };
+
+    struct LiveSample
+    {
+        // Zero when the slot is empty.
+        uintptr_t address;
+        uint32_t stack;
+        size_t size;
+        double weight;
+    };
+
+    std::atomic<bool> gEnabled{ false };
+    std::atomic<size_t> gSampleInterval{ DEFAULT_HEAP_SAMPLE_INTERVAL };
+    std::atomic<uint64_t> gSeedCounter{ 0 };
+
+    // Frees skip everything while there are no live samples, and otherwise only take the lock when
+    // their filter entry, a count of live samples whose address hashes to it, is non-zero. An entry
+    // that reaches FILTER_SATURATED stays there, since its count is no longer exact.
+    std::atomic<uint64_t> gLiveSampleCount{ 0 };
+    std::atomic<uint8_t> gLiveFilter[FILTER_SIZE];
+
+    // Guards everything below. Only taken for samples and for frees that pass the filter.
+    std::mutex gMutex;
+    StackRecord* gStacks = nullptr;
+    LiveSample* gLive = nullptr;
+    uint32_t gStackCount = 0;
+    uint64_t gSamples = 0;
+    uint64_t gDroppedSamples = 0;
+
+    // Plain thread-locals, so they are safe to touch from operator new while a thread starts or exits.
+    thread_local int64_t tBytesUntilSample = 0;
+    thread_local uint64_t tRandom = 0;
+    thread_local bool tInProfiler = false;
+
+    // Allocations made by the profiler itself, or by backtrace() and dladdr(), are not sampled.
+    struct ProfilerGuard
+    {
+        ProfilerGuard() { tInProfiler = true; }
+        ~ProfilerGuard() { tInProfiler = false; }
+    };
+
+    uint64_t NextRandom(uint64_t& state)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Exponentially distributed, so samples form a Poisson process over allocated bytes and every
+    // byte has the same chance of being sampled, however the allocations are sized.
+    int64_t NextSampleInterval()
+    {
+        double uniform = static_cast<double>(NextRandom(tRandom) >> 11) * (1.0 / 9007199254740992.0);
+        double interval = -std::log(1.0 - uniform) * static_cast<double>(gSampleInterval.load(std::memory_order_relaxed));
+        return interval < 1e15 ? static_cast<int64_t>(interval) + 1 : static_cast<int64_t>(1e15);
+    }
+
+    uint64_t HashAddress(const void* memory)
+    {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(memory)) * 0x9E3779B97F4A7C15ull;
+    }
+
+    size_t GetLiveHome(uint64_t hash)
+    {
+        return static_cast<size_t>(hash >> 48) & (LIVE_CAPACITY - 1);
+    }
+
+    size_t GetFilterIndex(uint64_t hash)
+    {
+        return static_cast<size_t>(hash >> 32) & (FILTER_SIZE - 1);
+    }
+
+    uint64_t HashStack(void* const* frames, uint32_t depth)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (uint32_t i = 0; i < depth; ++i)
+        {
+            hash = (hash ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(frames[i]))) * 0x100000001B3ull;
+        }
+        return hash ^ (hash >> 29);
+    }
+
+    uint32_t FindOrAddStack(uint64_t hash, void* const* frames, uint32_t depth)
+    {
+        size_t mask = STACK_CAPACITY - 1;
+        for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask)
+        {
+            StackRecord& record = gStacks[slot];
+            if (!record.used)
+            {
+                // Kept at most three quarters full so probes stay short.
+                if (gStackCount >= STACK_CAPACITY / 4 * 3)
+                {
+                    return NO_STACK;
+                }
+
+                record.used = true;
+                record.hash = hash;
+                record.depth = depth;
+                memcpy(record.frames, frames, depth * sizeof(void*));
+                ++gStackCount;
+                return static_cast<uint32_t>(slot);
+            }
+            if (record.hash == hash && record.depth == depth && memcmp(record.frames, frames, depth * sizeof(void*)) == 0)
+            {
+                return static_cast<uint32_t>(slot);
+            }
+        }
+    }
+
+    size_t FindLive(uintptr_t address, uint64_t hash)
+    {
+        size_t mask = LIVE_CAPACITY - 1;
+        for (size_t slot = GetLiveHome(hash); gLive[slot].address != 0; slot = (slot + 1) & mask)
+        {
+            if (gLive[slot].address == address)
+            {
+                return slot;
+            }
+        }
+        return LIVE_CAPACITY;
+    }
+
+    // Linear probing with backward shift deletion, so there are no tombstones to clean up.
+    void RemoveLive(size_t hole)
+    {
+        size_t mask = LIVE_CAPACITY - 1;
+        for (size_t next = (hole + 1) & mask; gLive[next].address != 0; next = (next + 1) & mask)
+        {
+            size_t home = GetLiveHome(HashAddress(reinterpret_cast<void*>(gLive[next].address)));
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                gLive[hole] = gLive[next];
+                hole = next;
+            }
+        }
+        gLive[hole].address = 0;
+    }
+
+    HEAP_PROFILER_NOINLINE void SampleAllocation(void* memory, size_t size)
+    {
+        ProfilerGuard guard;
+
+        void* frames[MAX_FRAMES + SKIPPED_FRAMES];
+        int captured = 0;
+#if defined(HEAP_PROFILER_USE_BACKTRACE)
+        captured = backtrace(frames, static_cast<int>(MAX_FRAMES + SKIPPED_FRAMES));
+#endif
+        uint32_t depth = captured > SKIPPED_FRAMES ? static_cast<uint32_t>(captured - SKIPPED_FRAMES) : 0;
+        void* const* stack = frames + SKIPPED_FRAMES;
+
+        // The chance that a countdown with this mean crosses zero within 'size' bytes.
+        double interval = static_cast<double>(gSampleInterval.load(std::memory_order_relaxed));
+        double probability = 1.0 - std::exp(-static_cast<double>(size) / interval);
+        double weight = probability > 0.0 ? 1.0 / probability : 1.0;
+        uint64_t stackHash = HashStack(stack, depth);
+        uint64_t addressHash = HashAddress(memory);
+
+        std::lock_guard<std::mutex> lock(gMutex);
+        ++gSamples;
+
+        uint32_t stackIndex = FindOrAddStack(stackHash, stack, depth);
+        if (stackIndex == NO_STACK || gLiveSampleCount.load(std::memory_order_relaxed) >= LIVE_CAPACITY / 4 * 3)
+        {
+            ++gDroppedSamples;
+            return;
+        }
+
+        StackRecord& record = gStacks[stackIndex];
+        record.allocatedCount += weight;
+        record.allocatedBytes += weight * static_cast<double>(size);
+
+        size_t slot = GetLiveHome(addressHash);
+        while (gLive[slot].address != 0)
+        {
+            slot = (slot + 1) & (LIVE_CAPACITY - 1);
+        }
+        gLive[slot] = { reinterpret_cast<uintptr_t>(memory), stackIndex, size, weight };
+
+        std::atomic<uint8_t>& filter = gLiveFilter[GetFilterIndex(addressHash)];
+        uint8_t count = filter.load(std::memory_order_relaxed);
+        if (count != FILTER_SATURATED)
+        {
+            filter.store(count + 1, std::memory_order_relaxed);
+        }
+        gLiveSampleCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void WriteFrameName(FILE* file, void* frame)
+    {
+#if defined(HEAP_PROFILER_USE_BACKTRACE)
+        // A return address points after the call, so the byte before it is still in the caller.
+        const char* address = static_cast<const char*>(frame) - 1;
+        Dl_info info;
+        if (dladdr(address, &info) != 0)
+        {
+            if (info.dli_sname != nullptr)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                fputs(status == 0 && demangled != nullptr ? demangled : info.dli_sname, file);
+                free(demangled);
+                return;
+            }
+            if (info.dli_fname != nullptr)
+            {
+                const char* baseName = strrchr(info.dli_fname, '/');
+                fprintf(file, "%s+0x%llx", baseName != nullptr ? baseName + 1 : info.dli_fname,
+                    static_cast<unsigned long long>(address - static_cast<const char*>(info.dli_fbase)));
+                return;
+            }
+        }
+#endif
+        fprintf(file, "0x%llx", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(frame)));
+    }
+
+    unsigned long long Round(double value)
+    {
+        return value > 0.0 ? static_cast<unsigned long long>(value + 0.5) : 0;
+    }
+
+    void WritePprof(FILE* file)
+    {
+        double liveCount = 0.0;
+        double liveBytes = 0.0;
+        double allocatedCount = 0.0;
+        double allocatedBytes = 0.0;
+        for (size_t i = 0; i < STACK_CAPACITY; ++i)
+        {
+            const StackRecord& record = gStacks[i];
+            if (record.used)
+            {
+                liveCount += record.allocatedCount - record.freedCount;
+                liveBytes += record.allocatedBytes - record.freedBytes;
+                allocatedCount += record.allocatedCount;
+                allocatedBytes += record.allocatedBytes;
+            }
+        }
+
+        // Values are already scaled up to the whole heap, so the header names no sampling period.
+        fprintf(file, "heap profile: %llu: %llu [%llu: %llu] @ heapprofile\n", Round(liveCount), Round(liveBytes),
+            Round(allocatedCount), Round(allocatedBytes));
+        for (size_t i = 0; i < STACK_CAPACITY; ++i)
+        {
+            const StackRecord& record = gStacks[i];
+            if (!record.used)
+            {
+                continue;
+            }
+
+            fprintf(file, "%llu: %llu [%llu: %llu] @", Round(record.allocatedCount - record.freedCount),
+                Round(record.allocatedBytes - record.freedBytes), Round(record.allocatedCount), Round(record.allocatedBytes));
+            for (uint32_t f = 0; f < record.depth; ++f)
+            {
+                fprintf(file, " 0x%llx", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(record.frames[f])));
+            }
+            fputc('\n', file);
+        }
+
+        // pprof maps the addresses back to binaries and symbols with the process's mappings.
+        fprintf(file, "\nMAPPED_LIBRARIES:\n");
+#if defined(__linux__)
+        FILE* maps = fopen("/proc/self/maps", "r");
+        if (maps != nullptr)
+        {
+            char buffer[4096];
+            size_t length;
+            while ((length = fread(buffer, 1, sizeof(buffer), maps)) > 0)
+            {
+                fwrite(buffer, 1, length, file);
+            }
+            fclose(maps);
+        }
+#endif
+    }
+
+    void WriteFolded(FILE* file, HeapProfileView view)
+    {
+        for (size_t i = 0; i < STACK_CAPACITY; ++i)
+        {
+            const StackRecord& record = gStacks[i];
+            unsigned long long value = Round(view == HeapProfileView::LiveBytes ? record.allocatedBytes - record.freedBytes : record.allocatedBytes);
+            if (!record.used || value == 0)
+            {
+                continue;
+            }
+
+            // Outermost frame first.
+            if (record.depth == 0)
+            {
+                fputs("[unknown]", file);
+            }
+            for (uint32_t f = record.depth; f > 0; --f)
+            {
+                WriteFrameName(file, record.frames[f - 1]);
+                if (f > 1)
+                {
+                    fputc(';', file);
+                }
+            }
+            fprintf(file, " %llu\n", value);
+        }
+    }
+}
+
+bool StartHeapProfiler(size_t sampleIntervalBytes)
+{
+    ProfilerGuard guard;
+
+#if defined(HEAP_PROFILER_USE_BACKTRACE)
+    // The first backtrace() loads the unwinder, which allocates. Better here than inside a hook.
+    void* frame;
+    backtrace(&frame, 1);
+#endif
+
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (gStacks == nullptr)
+    {
+        // From malloc, which the hooks do not see.
+        gStacks = static_cast<StackRecord*>(calloc(STACK_CAPACITY, sizeof(StackRecord)));
+        gLive = static_cast<LiveSample*>(calloc(LIVE_CAPACITY, sizeof(LiveSample)));
+        if (gStacks == nullptr || gLive == nullptr)
+        {
+            free(gStacks);
+            free(gLive);
+            gStacks = nullptr;
+            gLive = nullptr;
+            return false;
+        }
+    }
+
+    gSampleInterval.store(sampleIntervalBytes > 0 ? sampleIntervalBytes : 1, std::memory_order_relaxed);
+    gEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void StopHeapProfiler()
+{
+    gEnabled.store(false, std::memory_order_relaxed);
+}
+
+void RecordHeapAllocation(void* memory, size_t size)
+{
+    if (!gEnabled.load(std::memory_order_relaxed) || memory == nullptr)
+    {
+        return;
+    }
+
+    tBytesUntilSample -= static_cast<int64_t>(size);
+    if (tBytesUntilSample >= 0 || tInProfiler)
+    {
+        return;
+    }
+
+    // A thread's first allocation only seeds its countdown, so threads do not all sample their
+    // first allocation.
+    if (tRandom == 0)
+    {
+        tRandom = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&tRandom)) ^ 0x9E3779B97F4A7C15ull) +
+            gSeedCounter.fetch_add(1, std::memory_order_relaxed) * 0xBF58476D1CE4E5B9ull;
+        tRandom = tRandom != 0 ? tRandom : 1;
+        tBytesUntilSample = NextSampleInterval();
+        return;
+    }
+
+    // Not a tail call, so this function's frame is still on the stack for SKIPPED_FRAMES.
+    SampleAllocation(memory, size);
+    tBytesUntilSample = NextSampleInterval();
+}
+
+void RecordHeapFree(void* memory)
+{
+    if (memory == nullptr || gLiveSampleCount.load(std::memory_order_relaxed) == 0 || tInProfiler)
+    {
+        return;
+    }
+
+    uint64_t hash = HashAddress(memory);
+    std::atomic<uint8_t>& filter = gLiveFilter[GetFilterIndex(hash)];
+    if (filter.load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+
+    ProfilerGuard guard;
+    std::lock_guard<std::mutex> lock(gMutex);
+    size_t slot = FindLive(reinterpret_cast<uintptr_t>(memory), hash);
+    if (slot == LIVE_CAPACITY)
+    {
+        return;
+    }
+
+    const LiveSample& sample = gLive[slot];
+    StackRecord& record = gStacks[sample.stack];
+    record.freedCount += sample.weight;
+    record.freedBytes += sample.weight * static_cast<double>(sample.size);
+    RemoveLive(slot);
+
+    uint8_t count = filter.load(std::memory_order_relaxed);
+    if (count != FILTER_SATURATED)
+    {
+        filter.store(count - 1, std::memory_order_relaxed);
+    }
+    gLiveSampleCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool WriteHeapProfile(const char* path, HeapProfileFormat format, HeapProfileView view)
+{
+    ProfilerGuard guard;
+    FILE* file = fopen(path, "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(gMutex);
+        if (gStacks != nullptr)
+        {
+            if (format == HeapProfileFormat::Pprof)
+            {
+                WritePprof(file);
+            }
+            else
+            {
+                WriteFolded(file, view);
+            }
+        }
+    }
+    return fclose(file) == 0;
+}
+
+HeapProfileSummary GetHeapProfileSummary()
+{
+    HeapProfileSummary summary = {};
+    std::lock_guard<std::mutex> lock(gMutex);
+    summary.samples = gSamples;
+    summary.liveSamples = gLiveSampleCount.load(std::memory_order_relaxed);
+    summary.droppedSamples = gDroppedSamples;
+    summary.stackCount = gStackCount;
+    for (size_t i = 0; gStacks != nullptr && i < STACK_CAPACITY; ++i)
+    {
+        const StackRecord& record = gStacks[i];
+        if (record.used)
+        {
+            summary.estimatedAllocatedBytes += record.allocatedBytes;
+            summary.estimatedLiveBytes += record.allocatedBytes - record.freedBytes;
+        }
+    }
+    return summary;
+}
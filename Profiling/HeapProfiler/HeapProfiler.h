@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// A sampling heap profiler driven from the executable's allocation hooks. Call
+// RecordHeapAllocation() from global operator new after allocating and RecordHeapFree() from
+// operator delete before freeing. The EASTL operator new[] hooks allocate through global new, so
+// EASTL allocations are covered too.
+//
+// Samples are taken by bytes allocated rather than by call: every thread counts down a random,
+// exponentially distributed number of bytes, with a mean of the sample interval, and samples the
+// allocation that crosses zero. Large allocations are therefore sampled more often than small
+// ones, and each sample is weighted by the inverse of its chance of being sampled so that the
+// totals estimate the whole heap. Unsampled allocations cost a thread-local subtraction and
+// unsampled frees a single byte load.
+//
+// A sample records its call stack, and stays live until the allocation is freed. Profiles can be
+// written in the legacy pprof heap format, which pprof symbolises itself, or as folded stacks for
+// flame graph tools. Stacks are captured with backtrace(), so on platforms without it samples
+// are still counted but have no stack.
+constexpr size_t DEFAULT_HEAP_SAMPLE_INTERVAL = 512 * 1024;
+
+enum class HeapProfileFormat
+{
+    // "heap profile: ..." text as written by gperftools, including the process's mappings.
+    Pprof,
+    // One "outer;...;inner bytes" line per stack, symbolised with dladdr().
+    Folded
+};
+
+enum class HeapProfileView
+{
+    LiveBytes,
+    AllocatedBytes
+};
+
+struct HeapProfileSummary
+{
+    uint64_t samples;
+    uint64_t liveSamples;
+    // Samples not tracked because the stack or live tables were full.
+    uint64_t droppedSamples;
+    uint32_t stackCount;
+    double estimatedAllocatedBytes;
+    double estimatedLiveBytes;
+};
+
+// Allocates the profiler's tables, outside the allocation hooks, and starts sampling. Returns
+// false if the tables cannot be allocated.
+bool StartHeapProfiler(size_t sampleIntervalBytes = DEFAULT_HEAP_SAMPLE_INTERVAL);
+
+// Stops taking new samples. Frees of live samples are still recorded and the profile can still be
+// written.
+void StopHeapProfiler();
+
+void RecordHeapAllocation(void* memory, size_t size);
+void RecordHeapFree(void* memory);
+
+// 'view' picks the value of each folded stack; pprof profiles always carry both.
+bool WriteHeapProfile(const char* path, HeapProfileFormat format, HeapProfileView view = HeapProfileView::LiveBytes);
+
+HeapProfileSummary GetHeapProfileSummary();
@@ -0,0 +1,218 @@
+#include "Stats.h"
+
+#include <cstring>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Stats in shared memory need address-free atomics");
+
+namespace
+{
+    StatsSegment gLocalSegment = { STATS_SEGMENT_MAGIC, STATS_SEGMENT_VERSION, MAX_THREADS, 0, {} };
+    std::atomic<StatsSegment*> gSegment{ &gLocalSegment };
+
+    constexpr const char* COUNTER_NAMES[STAT_COUNTER_COUNT] =
+    {
+        "calls", "bytes formatted", "EASTL allocations", "EASTL allocated bytes", "cache hits", "cache misses"
+    };
+
+    constexpr const char* HISTOGRAM_NAMES[STAT_HISTOGRAM_COUNT] = { "ns per call", "bytes per call" };
+
+    void CopyBlock(const ThreadStatsBlock& source, ThreadStatsBlock& destination)
+    {
+        for (size_t c = 0; c < STAT_COUNTER_COUNT; ++c)
+        {
+            destination.counters[c].store(source.counters[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (size_t h = 0; h < STAT_HISTOGRAM_COUNT; ++h)
+        {
+            for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+            {
+                destination.histograms[h][b].store(source.histograms[h][b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+ThreadStatsBlock& GetThreadStats()
+{
+    // The block only moves if ExportStats() swaps the segment, so it is cached per thread.
+    thread_local StatsSegment* tSegment = nullptr;
+    thread_local ThreadStatsBlock* tBlock = nullptr;
+
+    StatsSegment* segment = gSegment.load(std::memory_order_acquire);
+    if (segment != tSegment)
+    {
+        tBlock = &segment->threads[GetThreadIndex()];
+        tSegment = segment;
+    }
+    return *tBlock;
+}
+
+bool ExportStats(const char* segmentName)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    int fd = shm_open(segmentName, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, sizeof(StatsSegment)) == 0)
+    {
+        memory = mmap(nullptr, sizeof(StatsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        shm_unlink(segmentName);
+        return false;
+    }
+
+    // The segment may be left over from an earlier run, so it is cleared and the magic written
+    // last for a reader that opens it in between.
+    StatsSegment* segment = static_cast<StatsSegment*>(memory);
+    memset(static_cast<void*>(segment), 0, sizeof(StatsSegment));
+    StatsSegment* current = gSegment.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < MAX_THREADS; ++i)
+    {
+        CopyBlock(current->threads[i], segment->threads[i]);
+    }
+    segment->version = STATS_SEGMENT_VERSION;
+    segment->threadCapacity = MAX_THREADS;
+    segment->processId = static_cast<uint32_t>(getpid());
+    std::atomic_thread_fence(std::memory_order_release);
+    segment->magic = STATS_SEGMENT_MAGIC;
+
+    gSegment.store(segment, std::memory_order_release);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void UnlinkStats(const char* segmentName)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    shm_unlink(segmentName);
+#endif
+}
+
+const StatsSegment* OpenStatsSegment(const char* segmentName)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    int fd = shm_open(segmentName, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat status = {};
+    void* memory = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(StatsSegment))
+    {
+        memory = mmap(nullptr, sizeof(StatsSegment), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    const StatsSegment* segment = static_cast<const StatsSegment*>(memory);
+    if (segment->magic != STATS_SEGMENT_MAGIC || segment->version != STATS_SEGMENT_VERSION || segment->threadCapacity != MAX_THREADS)
+    {
+        CloseStatsSegment(segment);
+        return nullptr;
+    }
+    return segment;
+#else
+    return nullptr;
+#endif
+}
+
+void CloseStatsSegment(const StatsSegment* segment)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    if (segment != nullptr)
+    {
+        munmap(const_cast<StatsSegment*>(segment), sizeof(StatsSegment));
+    }
+#endif
+}
+
+void AggregateStats(const StatsSegment& segment, StatsSnapshot& snapshot)
+{
+    memset(&snapshot, 0, sizeof(snapshot));
+    for (uint32_t i = 0; i < MAX_THREADS; ++i)
+    {
+        const ThreadStatsBlock& block = segment.threads[i];
+        bool active = false;
+        for (size_t c = 0; c < STAT_COUNTER_COUNT; ++c)
+        {
+            uint64_t value = block.counters[c].load(std::memory_order_relaxed);
+            snapshot.counters[c] += value;
+            active |= value != 0;
+        }
+        for (size_t h = 0; h < STAT_HISTOGRAM_COUNT; ++h)
+        {
+            for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+            {
+                uint64_t value = block.histograms[h][b].load(std::memory_order_relaxed);
+                snapshot.histograms[h][b] += value;
+                active |= value != 0;
+            }
+        }
+        snapshot.activeThreads += active ? 1 : 0;
+    }
+}
+
+StatsSnapshot TakeStatsSnapshot()
+{
+    StatsSnapshot snapshot;
+    AggregateStats(*gSegment.load(std::memory_order_acquire), snapshot);
+    return snapshot;
+}
+
+uint64_t GetHistogramPercentile(const uint64_t* buckets, double percentile)
+{
+    uint64_t total = 0;
+    for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+    {
+        total += buckets[b];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+    {
+        seen += buckets[b];
+        if (seen > rank)
+        {
+            return b == HISTOGRAM_BUCKETS - 1 ? UINT64_MAX : (uint64_t(1) << b) - 1;
+        }
+    }
+    return UINT64_MAX;
+}
+
+const char* GetStatCounterName(StatCounter counter)
+{
+    size_t index = static_cast<size_t>(counter);
+    return index < STAT_COUNTER_COUNT ? COUNTER_NAMES[index] : "unknown";
+}
+
+const char* GetStatHistogramName(StatHistogram histogram)
+{
+    size_t index = static_cast<size_t>(histogram);
+    return index < STAT_HISTOGRAM_COUNT ? HISTOGRAM_NAMES[index] : "unknown";
+}
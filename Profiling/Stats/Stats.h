@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "ThreadIndex.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+enum class StatCounter : uint32_t
+{
+    Calls,
+    BytesFormatted,
+    // Seen by the EASTL operator new[] hooks.
+    EastlAllocations,
+    EastlAllocatedBytes,
+    // Lookups in a TemplateCache with CountCacheLookup() as its lookup hook.
+    CacheHits,
+    CacheMisses,
+    Count
+};
+
+enum class StatHistogram : uint32_t
+{
+    CallNanoseconds,
+    CallBytes,
+    Count
+};
+
+constexpr size_t STAT_COUNTER_COUNT = static_cast<size_t>(StatCounter::Count);
+constexpr size_t STAT_HISTOGRAM_COUNT = static_cast<size_t>(StatHistogram::Count);
+
+// Bucket 0 counts zeros and bucket b counts values in [2^(b-1), 2^b). The last bucket is open ended.
+constexpr size_t HISTOGRAM_BUCKETS = 64;
+
+// One thread's stats. Only the owning thread writes them, with a plain load and store rather than a
+// locked read-modify-write, and each block starts on its own cache line so no two threads ever
+// write to the same line. Totals are only computed when someone asks for them.
+struct alignas(64) ThreadStatsBlock
+{
+    std::atomic<uint64_t> counters[STAT_COUNTER_COUNT];
+    std::atomic<uint64_t> histograms[STAT_HISTOGRAM_COUNT][HISTOGRAM_BUCKETS];
+};
+
+constexpr uint32_t STATS_SEGMENT_MAGIC = 0x53544D50;
+constexpr uint32_t STATS_SEGMENT_VERSION = 1;
+
+// Every thread's block, indexed by GetThreadIndex(). This is also the exact layout of an exported
+// shared memory segment, so a reader in another process sums the same memory the writers update.
+// A recycled thread index keeps adding to its block, so totals only ever grow.
+struct StatsSegment
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t threadCapacity;
+    uint32_t processId;
+    ThreadStatsBlock threads[MAX_THREADS];
+};
+
+struct StatsSnapshot
+{
+    uint64_t counters[STAT_COUNTER_COUNT];
+    uint64_t histograms[STAT_HISTOGRAM_COUNT][HISTOGRAM_BUCKETS];
+    // Threads that have recorded anything.
+    uint32_t activeThreads;
+};
+
+ThreadStatsBlock& GetThreadStats();
+
+// Callers recording several stats at once can fetch their block once and use these overloads.
+inline void AddStat(ThreadStatsBlock& stats, StatCounter counter, uint64_t value = 1)
+{
+    std::atomic<uint64_t>& slot = stats.counters[static_cast<size_t>(counter)];
+    slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void AddStat(StatCounter counter, uint64_t value = 1)
+{
+    AddStat(GetThreadStats(), counter, value);
+}
+
+// Matches TemplateCacheLookupHook, so the Stats library can count a template cache's lookups
+// without either library depending on the other:
+//     GetTemplateCache().SetLookupHook(CountCacheLookup, nullptr);
+inline void CountCacheLookup(bool hit, void* /*context*/)
+{
+    AddStat(hit ? StatCounter::CacheHits : StatCounter::CacheMisses);
+}
+
+inline size_t GetHistogramBucket(uint64_t value)
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    size_t bucket = index + 1;
+#else
+    size_t bucket = 64 - static_cast<size_t>(__builtin_clzll(value));
+#endif
+    return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+inline void RecordStat(ThreadStatsBlock& stats, StatHistogram histogram, uint64_t value)
+{
+    std::atomic<uint64_t>& slot = stats.histograms[static_cast<size_t>(histogram)][GetHistogramBucket(value)];
+    slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+inline void RecordStat(StatHistogram histogram, uint64_t value)
+{
+    RecordStat(GetThreadStats(), histogram, value);
+}
+
+// Moves the stats into a named POSIX shared memory segment, such as "/prankmoe-stats", which
+// StatsTool can map and read while this process runs. Counts recorded so far are carried over.
+// Call it at startup, before other threads record stats, since their updates during the move
+// can be lost. Returns false if the segment cannot be created, or on platforms without POSIX
+// shared memory, and the stats stay in process memory.
+bool ExportStats(const char* segmentName);
+
+// Removes the segment's name so that it goes away with the process. The mapping stays valid.
+void UnlinkStats(const char* segmentName);
+
+// Maps a segment exported by another process read-only. Returns nullptr if there is no such
+// segment or it was written by an incompatible version.
+const StatsSegment* OpenStatsSegment(const char* segmentName);
+void CloseStatsSegment(const StatsSegment* segment);
+
+void AggregateStats(const StatsSegment& segment, StatsSnapshot& snapshot);
+StatsSnapshot TakeStatsSnapshot();
+
+// The upper bound of the bucket holding the given percentile, in [0, 100].
+uint64_t GetHistogramPercentile(const uint64_t* buckets, double percentile);
+
+const char* GetStatCounterName(StatCounter counter);
+const char* GetStatHistogramName(StatHistogram histogram);
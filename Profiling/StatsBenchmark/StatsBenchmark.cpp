@@ -0,0 +1,209 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "Stats.h"
+#include "TemplateCache.h"
+
+// Set by each run's Install() before its threads start, and null while nothing is recorded.
+void (*gCountAllocation)(size_t size) = nullptr;
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	if (gCountAllocation != nullptr)
+	{
+		gCountAllocation(size);
+	}
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	if (gCountAllocation != nullptr)
+	{
+		gCountAllocation(size);
+	}
+	return new uint8_t[size];
+}
+
+constexpr eastl::string_view MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// What every call is charged with: one call, the bytes it formatted and how long it took, plus
+// the cache lookup and EASTL allocations it made through the hooks Install() sets up.
+struct NoStats
+{
+    static void Install()
+    {
+        gCountAllocation = nullptr;
+        GetTemplateCache().SetLookupHook(nullptr, nullptr);
+    }
+
+    static void Record(uint64_t nanoseconds, size_t bytes) {}
+};
+
+// The obvious alternative: counters every thread increments. Each update is a locked instruction
+// on a cache line that every core keeps stealing from the others.
+std::atomic<uint64_t> gCalls{ 0 };
+std::atomic<uint64_t> gBytesFormatted{ 0 };
+std::atomic<uint64_t> gCacheHits{ 0 };
+std::atomic<uint64_t> gCacheMisses{ 0 };
+std::atomic<uint64_t> gEastlAllocations{ 0 };
+std::atomic<uint64_t> gEastlAllocatedBytes{ 0 };
+std::atomic<uint64_t> gHistograms[STAT_HISTOGRAM_COUNT][HISTOGRAM_BUCKETS];
+
+struct GlobalAtomicStats
+{
+    static void CountAllocation(size_t size)
+    {
+        gEastlAllocations.fetch_add(1, std::memory_order_relaxed);
+        gEastlAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    static void CountCacheLookup(bool hit, void* /*context*/)
+    {
+        (hit ? gCacheHits : gCacheMisses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void Install()
+    {
+        gCountAllocation = CountAllocation;
+        GetTemplateCache().SetLookupHook(CountCacheLookup, nullptr);
+    }
+
+    static void Record(uint64_t nanoseconds, size_t bytes)
+    {
+        gCalls.fetch_add(1, std::memory_order_relaxed);
+        gBytesFormatted.fetch_add(bytes, std::memory_order_relaxed);
+        gHistograms[static_cast<size_t>(StatHistogram::CallNanoseconds)][GetHistogramBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        gHistograms[static_cast<size_t>(StatHistogram::CallBytes)][GetHistogramBucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+struct PerThreadStats
+{
+    static void CountAllocation(size_t size)
+    {
+        ThreadStatsBlock& stats = GetThreadStats();
+        AddStat(stats, StatCounter::EastlAllocations);
+        AddStat(stats, StatCounter::EastlAllocatedBytes, size);
+    }
+
+    static void Install()
+    {
+        gCountAllocation = CountAllocation;
+        GetTemplateCache().SetLookupHook(CountCacheLookup, nullptr);
+    }
+
+    static void Record(uint64_t nanoseconds, size_t bytes)
+    {
+        ThreadStatsBlock& stats = GetThreadStats();
+        AddStat(stats, StatCounter::Calls);
+        AddStat(stats, StatCounter::BytesFormatted, bytes);
+        RecordStat(stats, StatHistogram::CallNanoseconds, nanoseconds);
+        RecordStat(stats, StatHistogram::CallBytes, bytes);
+    }
+};
+
+eastl::string_view FirstName(eastl::string_view fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    return delimiterPosition != eastl::string_view::npos ? fullName.substr(0, delimiterPosition) : fullName;
+}
+
+template <typename Stats>
+size_t PrankMoe(eastl::string_view fullName, char* buffer, size_t capacity)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t length = FormatCachedTemplate(MOE_DIALOGUE_1, { FirstName(fullName), fullName }, buffer, capacity);
+    uint64_t nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    Stats::Record(nanoseconds, length);
+    return length;
+}
+
+template <typename Stats>
+void TimeThreads(const char* label, unsigned threadCount, size_t callsPerThread)
+{
+    Stats::Install();
+    std::atomic<size_t> totalBytes{ 0 };
+    auto start = std::chrono::steady_clock::now();
+
+    eastl::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t)
+    {
+        threads.push_back(std::thread([t, callsPerThread, &totalBytes]
+        {
+            // Each call parses a name into an eastl::string, which the EASTL hooks count.
+            size_t bytes = 0;
+            char buffer[256];
+            for (size_t i = 0; i < callsPerThread; ++i)
+            {
+                size_t index = t * callsPerThread + i;
+                char name[64];
+                int length = snprintf(name, sizeof(name), "%s%zu %s of Springfield", FIRST_NAMES[index % 10], index, SURNAMES[(index / 10) % 10]);
+                eastl::string fullName(name, length > 0 ? static_cast<size_t>(length) : 0);
+                bytes += PrankMoe<Stats>(eastl::string_view(fullName.data(), fullName.length()), buffer, sizeof(buffer));
+            }
+            totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    size_t calls = threadCount * callsPerThread;
+    printf("%-44s %8.1f ms  %6.1f ns/call  (%zu bytes)\n", label, nanoseconds / 1e6,
+        nanoseconds / static_cast<double>(calls), totalBytes.load());
+}
+
+int main(int argc, char** argv)
+{
+    unsigned threadCount = argc > 1 ? static_cast<unsigned>(strtoul(argv[1], nullptr, 10)) : 4;
+    size_t callsPerThread = argc > 2 ? strtoull(argv[2], nullptr, 10) : 2000000;
+    const char* segmentName = argc > 3 ? argv[3] : nullptr;
+    if (threadCount == 0 || callsPerThread == 0)
+    {
+        printf("Usage: StatsBenchmark [threads] [callsPerThread] [segmentName]\n");
+        return 1;
+    }
+
+    // Exported before any other thread starts, so StatsTool can watch the runs below live.
+    if (segmentName != nullptr)
+    {
+        if (!ExportStats(segmentName))
+        {
+            printf("Could not export stats to %s\n", segmentName);
+            return 1;
+        }
+        printf("Stats exported to %s, run StatsTool %s to watch\n", segmentName, segmentName);
+    }
+
+    TimeThreads<NoStats>("No stats", threadCount, callsPerThread);
+    TimeThreads<GlobalAtomicStats>("Global atomic counters", threadCount, callsPerThread);
+    TimeThreads<PerThreadStats>("Per-thread stats blocks", threadCount, callsPerThread);
+    NoStats::Install();
+
+    StatsSnapshot snapshot = TakeStatsSnapshot();
+    printf("\n%u threads recorded stats\n", snapshot.activeThreads);
+    for (size_t c = 0; c < STAT_COUNTER_COUNT; ++c)
+    {
+        printf("  %-24s %16llu\n", GetStatCounterName(static_cast<StatCounter>(c)), static_cast<unsigned long long>(snapshot.counters[c]));
+    }
+    const uint64_t* callNanoseconds = snapshot.histograms[static_cast<size_t>(StatHistogram::CallNanoseconds)];
+    printf("  %-24s p50 <= %llu, p99 <= %llu\n", GetStatHistogramName(StatHistogram::CallNanoseconds),
+        static_cast<unsigned long long>(GetHistogramPercentile(callNanoseconds, 50)),
+        static_cast<unsigned long long>(GetHistogramPercentile(callNanoseconds, 99)));
+
+    if (segmentName != nullptr)
+    {
+        UnlinkStats(segmentName);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "Stats.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void PrintSnapshot(const StatsSnapshot& previous, const StatsSnapshot& current, double seconds)
+{
+    printf("%u threads\n", current.activeThreads);
+    for (size_t c = 0; c < STAT_COUNTER_COUNT; ++c)
+    {
+        uint64_t delta = current.counters[c] - previous.counters[c];
+        printf("  %-24s %16llu  %14.0f/s\n", GetStatCounterName(static_cast<StatCounter>(c)),
+            static_cast<unsigned long long>(current.counters[c]), seconds > 0 ? static_cast<double>(delta) / seconds : 0.0);
+    }
+
+    // Percentiles over the interval only, so a change in behaviour shows up straight away.
+    for (size_t h = 0; h < STAT_HISTOGRAM_COUNT; ++h)
+    {
+        uint64_t buckets[HISTOGRAM_BUCKETS];
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+        {
+            buckets[b] = current.histograms[h][b] - previous.histograms[h][b];
+        }
+        printf("  %-24s %10s p50 <= %-10llu p99 <= %-10llu p99.9 <= %llu\n", GetStatHistogramName(static_cast<StatHistogram>(h)), "",
+            static_cast<unsigned long long>(GetHistogramPercentile(buckets, 50)),
+            static_cast<unsigned long long>(GetHistogramPercentile(buckets, 99)),
+            static_cast<unsigned long long>(GetHistogramPercentile(buckets, 99.9)));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* segmentName = argc > 1 ? argv[1] : nullptr;
+    unsigned intervalMilliseconds = argc > 2 ? static_cast<unsigned>(strtoul(argv[2], nullptr, 10)) : 1000;
+    unsigned sampleCount = argc > 3 ? static_cast<unsigned>(strtoul(argv[3], nullptr, 10)) : 0;
+    if (segmentName == nullptr || intervalMilliseconds == 0)
+    {
+        printf("Usage: StatsTool segmentName [intervalMilliseconds] [samples, 0 to run until the segment goes away]\n");
+        return 1;
+    }
+
+    const StatsSegment* segment = OpenStatsSegment(segmentName);
+    if (segment == nullptr)
+    {
+        printf("No stats segment named %s, or it was written by another version\n", segmentName);
+        return 1;
+    }
+
+    printf("Reading %s, exported by process %u\n", segmentName, segment->processId);
+
+    StatsSnapshot previous;
+    AggregateStats(*segment, previous);
+    std::chrono::steady_clock::time_point previousTime = std::chrono::steady_clock::now();
+    for (unsigned sample = 0; sampleCount == 0 || sample < sampleCount; ++sample)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMilliseconds));
+
+        StatsSnapshot current;
+        AggregateStats(*segment, current);
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        PrintSnapshot(previous, current, std::chrono::duration<double>(now - previousTime).count());
+        fflush(stdout);
+
+        previous = current;
+        previousTime = now;
+
+        // The writer unlinks the segment when it exits; the mapping stays readable but stops changing.
+        const StatsSegment* reopened = OpenStatsSegment(segmentName);
+        if (reopened == nullptr)
+        {
+            printf("%s has gone away\n", segmentName);
+            break;
+        }
+        CloseStatsSegment(reopened);
+    }
+
+    CloseStatsSegment(segment);
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <EASTL/sort.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "AdaptiveBatcher.h"
+#include "TemplateCatalog.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr eastl::string_view CATALOG =
+    "MOE_DIALOGUE_1=Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\\n\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+constexpr size_t NAME_COUNT = 4096;
+
+#if defined(_WIN32)
+constexpr const char* NULL_DEVICE = "NUL";
+#else
+constexpr const char* NULL_DEVICE = "/dev/null";
+#endif
+
+// Formats a batch and delivers it with a single unbuffered write, which stands in for the send
+// a service makes per response.
+struct Sink
+{
+    const CompiledTemplate* dialogue;
+    FILE* output;
+    eastl::string buffer;
+    eastl::vector<int64_t> latencies;
+};
+
+void HandleBatch(const BatchRequest* requests, size_t count, void* context)
+{
+    Sink& sink = *static_cast<Sink*>(context);
+    sink.buffer.clear();
+    FormatBatch(*sink.dialogue, requests, count, sink.buffer);
+    fwrite(sink.buffer.data(), 1, sink.buffer.length(), sink.output);
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+        sink.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - requests[i].arrival).count());
+    }
+}
+
+double Percentile(eastl::vector<int64_t>& values, size_t percent)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    eastl::vector<int64_t>::iterator nth = values.begin() + values.size() * percent / 100;
+    eastl::nth_element(values.begin(), nth, values.end());
+    return static_cast<double>(*nth);
+}
+
+std::chrono::nanoseconds DueAt(size_t index, double rate)
+{
+    return std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(index) * 1e9 / rate));
+}
+
+// Submits requests at 'rate' per second from this thread for 'seconds', stamping each with the
+// time it was due rather than the time it was submitted, so a slow batcher cannot hide its queue.
+void RunLoad(const char* label, const BatcherConfig& config, Sink& sink, const eastl::vector<eastl::string>& names,
+    double rate, double seconds)
+{
+    sink.latencies.clear();
+    AdaptiveBatcher batcher(config, HandleBatch, &sink);
+    batcher.Start();
+
+    size_t total = static_cast<size_t>(rate * seconds);
+    size_t submitted = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (submitted < total)
+    {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t due = static_cast<size_t>(elapsed * rate);
+        due = due < total ? due : total;
+        for (; submitted < due; ++submitted)
+        {
+            const eastl::string& name = names[submitted % names.size()];
+            batcher.Submit(eastl::string_view(name.data(), name.length()), start + DueAt(submitted, rate));
+        }
+        std::this_thread::sleep_until(start + DueAt(submitted, rate));
+    }
+    batcher.Stop();
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    BatcherStats stats = batcher.GetStats();
+    double p50 = Percentile(sink.latencies, 50);
+    double p99 = Percentile(sink.latencies, 99);
+    printf("%-44s %8.1f ms  %8.1f us p50  %8.1f us p99  %6.1f per batch (limit %zu)\n", label, milliseconds, p50 / 1e3, p99 / 1e3,
+        stats.batches > 0 ? static_cast<double>(stats.requests) / static_cast<double>(stats.batches) : 0.0, stats.batchLimit);
+}
+
+int main(int argc, char** argv)
+{
+    double lightRate = argc > 1 ? strtod(argv[1], nullptr) : 5000;
+    double heavyRate = argc > 2 ? strtod(argv[2], nullptr) : 2000000;
+    double seconds = argc > 3 ? strtod(argv[3], nullptr) : 2;
+    long long targetP99 = argc > 4 ? strtoll(argv[4], nullptr, 10) : 2000;
+    if (lightRate <= 0 || heavyRate <= 0 || seconds <= 0 || targetP99 <= 0)
+    {
+        printf("Usage: BatchingBenchmark [lightRequestsPerSecond] [heavyRequestsPerSecond] [seconds] [targetP99Microseconds]\n");
+        return 1;
+    }
+
+    TemplateCatalog catalog;
+    FILE* output = fopen(NULL_DEVICE, "wb");
+    if (!catalog.Load(CATALOG) || output == nullptr)
+    {
+        printf("Failed to set up the catalog or %s\n", NULL_DEVICE);
+        return 1;
+    }
+    setvbuf(output, nullptr, _IONBF, 0);
+
+    eastl::vector<eastl::string> names;
+    for (size_t i = 0; i < NAME_COUNT; ++i)
+    {
+        char buffer[64];
+        int length = snprintf(buffer, sizeof(buffer), "%s%zu %s of Springfield", FIRST_NAMES[i % 10], i, SURNAMES[(i / 10) % 10]);
+        names.push_back(eastl::string(buffer, length > 0 ? static_cast<size_t>(length) : 0));
+    }
+
+    Sink sink = { catalog.Find("MOE_DIALOGUE_1"), output, eastl::string(), eastl::vector<int64_t>() };
+
+    BatcherConfig single;
+    single.adaptive = false;
+    single.maxBatchSize = 1;
+
+    BatcherConfig fixed;
+    fixed.adaptive = false;
+    fixed.maxBatchSize = 64;
+
+    BatcherConfig adaptive;
+    adaptive.targetP99 = std::chrono::microseconds(targetP99);
+
+    const double rates[] = { lightRate, heavyRate };
+    for (double rate : rates)
+    {
+        printf("%.0f requests/s for %.1f s, p99 target %lld us\n", rate, seconds, static_cast<long long>(adaptive.targetP99.count()));
+        RunLoad("One request per call", single, sink, names, rate, seconds);
+        RunLoad("Fixed batches of 64, 500 us deadline", fixed, sink, names, rate, seconds);
+        RunLoad("AdaptiveBatcher, 500 us deadline", adaptive, sink, names, rate, seconds);
+    }
+
+    fclose(output);
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "AdaptiveBatcher.h"
+
+#include <EASTL/sort.h>
+#include "ServerUtilities.h"
+
+AdaptiveBatcher::AdaptiveBatcher(const BatcherConfig& config, BatchHandler handler, void* context)
+    : mConfig(config), mHandler(handler), mContext(context)
+{
+    if (mConfig.minBatchSize == 0)
+    {
+        mConfig.minBatchSize = 1;
+    }
+    if (mConfig.maxBatchSize < mConfig.minBatchSize)
+    {
+        mConfig.maxBatchSize = mConfig.minBatchSize;
+    }
+
+    // Adaptive batching starts from the lowest latency and grows only while there is latency to spare.
+    mBatchLimit.store(mConfig.adaptive ? mConfig.minBatchSize : mConfig.maxBatchSize, std::memory_order_relaxed);
+    mWindow.reserve(WINDOW_SIZE + mConfig.maxBatchSize);
+}
+
+AdaptiveBatcher::~AdaptiveBatcher()
+{
+    Stop();
+}
+
+void AdaptiveBatcher::Start()
+{
+    if (!mThread.joinable())
+    {
+        mStopping = false;
+        mThread = std::thread([this] { Run(); });
+    }
+}
+
+void AdaptiveBatcher::Stop()
+{
+    if (mThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mReady.notify_one();
+        mThread.join();
+    }
+}
+
+void AdaptiveBatcher::Submit(eastl::string_view name, std::chrono::steady_clock::time_point arrival)
+{
+    BatchRequest request;
+    request.name = name;
+    request.arrival = arrival;
+    Submit(request);
+}
+
+void AdaptiveBatcher::Submit(const BatchRequest& request)
+{
+    size_t pendingCount;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.push_back(request);
+        pendingCount = mPending.size();
+    }
+
+    // The batcher only waits for the first request of a batch or for the batch to fill, so every
+    // other submission can skip the wake-up.
+    if (pendingCount == 1 || pendingCount == GetBatchLimit())
+    {
+        mReady.notify_one();
+    }
+}
+
+BatcherStats AdaptiveBatcher::GetStats() const
+{
+    BatcherStats stats;
+    stats.requests = mRequests.load(std::memory_order_relaxed);
+    stats.batches = mBatches.load(std::memory_order_relaxed);
+    stats.batchLimit = GetBatchLimit();
+    stats.lastP99 = std::chrono::nanoseconds(mLastP99.load(std::memory_order_relaxed));
+    return stats;
+}
+
+void AdaptiveBatcher::Run()
+{
+    eastl::vector<BatchRequest> batch;
+    batch.reserve(mConfig.maxBatchSize);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (;;)
+    {
+        bool idle = mPending.empty();
+        mReady.wait(lock, [this] { return !mPending.empty() || mStopping; });
+        if (mPending.empty())
+        {
+            return;
+        }
+
+        size_t limit = GetBatchLimit();
+        bool backlogged = !idle && mPending.size() >= limit;
+        if (mPending.size() < limit && !mStopping)
+        {
+            std::chrono::steady_clock::time_point deadline = mPending.front().arrival + mConfig.maxDelay;
+            mReady.wait_until(lock, deadline, [&] { return mPending.size() >= limit || mStopping; });
+        }
+
+        size_t count = mPending.size() < limit ? mPending.size() : limit;
+        batch.assign(mPending.begin(), mPending.begin() + count);
+        mPending.erase(mPending.begin(), mPending.begin() + count);
+
+        lock.unlock();
+        mHandler(batch.data(), batch.size(), mContext);
+        Record(batch, backlogged);
+        lock.lock();
+    }
+}
+
+void AdaptiveBatcher::Record(const eastl::vector<BatchRequest>& batch, bool backlogged)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (const BatchRequest& request : batch)
+    {
+        mWindow.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - request.arrival).count());
+    }
+
+    ++mWindowBatches;
+    mWindowBacklogged += backlogged ? 1 : 0;
+    AddLocal(mRequests, batch.size());
+    AddLocal(mBatches, 1);
+
+    if (mWindow.size() >= WINDOW_SIZE)
+    {
+        Tune();
+    }
+}
+
+void AdaptiveBatcher::Tune()
+{
+    eastl::vector<int64_t>::iterator p99 = mWindow.begin() + mWindow.size() * 99 / 100;
+    eastl::nth_element(mWindow.begin(), p99, mWindow.end());
+    mLastP99.store(*p99, std::memory_order_relaxed);
+
+    if (mConfig.adaptive)
+    {
+        int64_t target = std::chrono::duration_cast<std::chrono::nanoseconds>(mConfig.targetP99).count();
+        bool backlogged = mWindowBacklogged * 2 > mWindowBatches;
+
+        size_t limit = GetBatchLimit();
+        if (*p99 > target)
+        {
+            limit = backlogged ? limit * 2 : limit - limit / 4 - 1;
+        }
+        else if (*p99 < target / 100 * static_cast<int64_t>(TARGET_LOW_PERCENT))
+        {
+            limit = limit + limit / 8 + 1;
+        }
+
+        limit = limit < mConfig.minBatchSize ? mConfig.minBatchSize : limit;
+        limit = limit > mConfig.maxBatchSize ? mConfig.maxBatchSize : limit;
+        mBatchLimit.store(limit, std::memory_order_relaxed);
+    }
+
+    mWindow.clear();
+    mWindowBatches = 0;
+    mWindowBacklogged = 0;
+}
+
+size_t FormatBatch(const CompiledTemplate& dialogue, const BatchRequest* requests, size_t count, eastl::string& output,
+    size_t* lengths)
+{
+    size_t start = output.length();
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t length = AppendResponse(dialogue, requests[i].name, output);
+        if (lengths != nullptr)
+        {
+            lengths[i] = length;
+        }
+    }
+    return output.length() - start;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <EASTL/deque.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+class CompiledTemplate;
+
+struct BatchRequest
+{
+    // Must stay valid until the batch holding it has been handled.
+    eastl::string_view name;
+    std::chrono::steady_clock::time_point arrival;
+    // Passed to the handler untouched, eg. the connection the answer goes back to.
+    void* tag = nullptr;
+};
+
+struct BatcherConfig
+{
+    size_t minBatchSize = 1;
+    size_t maxBatchSize = 256;
+
+    // The longest a request waits for its batch to fill, measured from its arrival.
+    std::chrono::microseconds maxDelay{ 500 };
+
+    // The p99 latency, from arrival until its batch has been handled, that the batch size is tuned
+    // against.
+    std::chrono::microseconds targetP99{ 2000 };
+
+    // When false every batch closes at maxBatchSize or maxDelay, whichever comes first.
+    bool adaptive = true;
+};
+
+struct BatcherStats
+{
+    uint64_t requests;
+    uint64_t batches;
+    size_t batchLimit;
+    std::chrono::nanoseconds lastP99;
+};
+
+// Called on the batcher's thread with every request in a batch, in arrival order.
+typedef void (*BatchHandler)(const BatchRequest* requests, size_t count, void* context);
+
+// Collects requests submitted from any thread into batches for a single handler thread. A batch
+// closes when it reaches the batch limit or its oldest request has waited maxDelay.
+//
+// With 'adaptive' set, the limit is retuned after every WINDOW_SIZE requests by comparing their
+// p99 latency with targetP99:
+// - Under TARGET_LOW_PERCENT of the target there is latency to spare, which bigger batches spend
+//   on fewer handler calls, so the limit grows by an eighth.
+// - Over the target the limit moves whichever way cuts latency. If batches were backlogged,
+//   meaning a full batch was already waiting when the handler became free, requests are queueing
+//   behind a handler that cannot keep up, so the limit doubles. Otherwise they are waiting for
+//   batches to fill, so it shrinks by a quarter, and at least by one.
+// - In between, the limit holds.
+// The limit therefore settles where p99 sits just under the target: at light load that is a
+// batch small enough to fill in time, and at heavy load one big enough to drain the queue.
+class AdaptiveBatcher
+{
+public:
+    static constexpr size_t WINDOW_SIZE = 256;
+    static constexpr size_t TARGET_LOW_PERCENT = 75;
+
+    AdaptiveBatcher(const BatcherConfig& config, BatchHandler handler, void* context);
+    ~AdaptiveBatcher();
+
+    AdaptiveBatcher(const AdaptiveBatcher&) = delete;
+    AdaptiveBatcher& operator=(const AdaptiveBatcher&) = delete;
+
+    void Start();
+
+    // Handles every request already submitted, then stops the batcher's thread.
+    void Stop();
+
+    void Submit(eastl::string_view name, std::chrono::steady_clock::time_point arrival = std::chrono::steady_clock::now());
+    void Submit(const BatchRequest& request);
+
+    size_t GetBatchLimit() const { return mBatchLimit.load(std::memory_order_relaxed); }
+    BatcherStats GetStats() const;
+
+private:
+    void Run();
+    void Record(const eastl::vector<BatchRequest>& batch, bool backlogged);
+    void Tune();
+
+    BatcherConfig mConfig;
+    BatchHandler mHandler;
+    void* mContext;
+
+    std::mutex mMutex;
+    std::condition_variable mReady;
+    eastl::deque<BatchRequest> mPending;
+    bool mStopping = false;
+    std::thread mThread;
+
+    // Read by Submit to decide when to wake the batcher.
+    std::atomic<size_t> mBatchLimit;
+
+    // Only touched by the batcher's thread.
+    eastl::vector<int64_t> mWindow;
+    size_t mWindowBatches = 0;
+    size_t mWindowBacklogged = 0;
+
+    std::atomic<uint64_t> mRequests{ 0 };
+    std::atomic<uint64_t> mBatches{ 0 };
+    std::atomic<int64_t> mLastP99{ 0 };
+};
+
+// The batch formatting path: appends MOE_DIALOGUE_1 for every request to 'output', so a batch is
+// delivered with one write instead of one per request. If 'lengths' is given, it receives the
+// length of each request's response. Returns the number of bytes appended.
+size_t FormatBatch(const CompiledTemplate& dialogue, const BatchRequest* requests, size_t count, eastl::string& output,
+    size_t* lengths = nullptr);
@@ -0,0 +1,891 @@
+#include "FormatServer.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <new>
+#include <EASTL/deque.h>
+#include <EASTL/utility.h>
+#include "ServerUtilities.h"
+#include "TemplateCatalog.h"
+#include "ThreadArena.h"
+#include "ThreadArenaAllocator.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr eastl::string_view DIALOGUE_KEY = "MOE_DIALOGUE_1";
+    constexpr size_t READ_SIZE = 16 * 1024;
+    constexpr int MAX_EVENTS = 64;
+
+    struct Connection
+    {
+        int fd;
+        // Position in the owner's list of open connections.
+        size_t slot;
+        // The start of a name whose newline has not arrived yet.
+        ThreadString pending;
+        // Responses the socket has not taken yet, from output[sent] on.
+        ThreadString output;
+        size_t sent;
+        // True while the connection waits to send its output rather than to read. A client that
+        // stops reading is then no longer read from either, and never blocks its thread.
+        bool writing;
+
+        // Batched mode only. Requests with the batcher that have not been answered yet; a
+        // connection that closes meanwhile is only freed once they have been.
+        size_t inFlight;
+        bool closing;
+        // Set while the connection is waiting for its share of the answers to be sent.
+        bool flushQueued;
+    };
+
+    void RemoveConnection(eastl::vector<Connection*>& connections, Connection* connection)
+    {
+        Connection* last = connections.back();
+        connections[connection->slot] = last;
+        last->slot = connection->slot;
+        connections.pop_back();
+    }
+
+#if defined(__linux__)
+    int OpenListener(uint16_t port, bool reusePort)
+    {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        int enable = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        if (reusePort && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    uint16_t GetBoundPort(int fd)
+    {
+        sockaddr_in address = {};
+        socklen_t length = sizeof(address);
+        return getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) == 0 ? ntohs(address.sin_port) : 0;
+    }
+
+    void PinToCore(unsigned index)
+    {
+        unsigned coreCount = std::thread::hardware_concurrency();
+        if (coreCount > 0)
+        {
+            cpu_set_t cores;
+            CPU_ZERO(&cores);
+            CPU_SET(index % coreCount, &cores);
+            pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+        }
+    }
+
+    bool AddToEpoll(int epoll, int fd, uint32_t events, void* data)
+    {
+        epoll_event event = {};
+        event.events = events;
+        event.data.ptr = data;
+        return epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+
+    // Waits for the connection to become readable, or writable while it has output to send.
+    bool WatchConnection(int epoll, int operation, Connection& connection, uint32_t flags)
+    {
+        epoll_event event = {};
+        event.events = (connection.writing ? EPOLLOUT : EPOLLIN) | flags;
+        event.data.ptr = &connection;
+        return epoll_ctl(epoll, operation, connection.fd, &event) == 0;
+    }
+
+    // Connections come from the calling thread's arena, and so do their buffers as they grow. Like
+    // the buffers, they abort if the arena runs out.
+    Connection* OpenConnection(int fd)
+    {
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        void* memory = ThreadArenaAllocator("FormatServer connection").allocate(sizeof(Connection), alignof(Connection), 0);
+        return new (memory) Connection{ fd, 0, ThreadString(), ThreadString(), 0, false, 0, false, false };
+    }
+
+    void CloseConnection(Connection* connection)
+    {
+        close(connection->fd);
+        connection->~Connection();
+        ThreadArena::Free(connection);
+    }
+
+    // Sends as much of the connection's output as the socket takes without blocking, and sets
+    // 'writing' if some is left. Returns false once the connection should be closed.
+    bool Flush(Connection& connection)
+    {
+        while (connection.sent < connection.output.length())
+        {
+            ssize_t sent = send(connection.fd, connection.output.data() + connection.sent, connection.output.length() - connection.sent, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                connection.writing = true;
+                return true;
+            }
+            if (sent <= 0)
+            {
+                return false;
+            }
+            connection.sent += static_cast<size_t>(sent);
+        }
+
+        connection.output.clear();
+        connection.sent = 0;
+        connection.writing = false;
+        return true;
+    }
+
+    // Called when a connection is ready. A writing connection carries on sending its output;
+    // otherwise this reads once and answers every name completed by the read. Returns false once
+    // the connection should be closed.
+    bool Serve(const CompiledTemplate& dialogue, Connection& connection, uint64_t& requests, uint64_t& responseBytes)
+    {
+        if (connection.writing)
+        {
+            return Flush(connection);
+        }
+
+        char data[READ_SIZE];
+        ssize_t received = recv(connection.fd, data, sizeof(data), 0);
+        if (received <= 0)
+        {
+            return received < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+
+        connection.pending.append(data, static_cast<size_t>(received));
+
+        size_t start = 0;
+        size_t end;
+        while ((end = connection.pending.find('\n', start)) != ThreadString::npos)
+        {
+            eastl::string_view fullName(connection.pending.data() + start, end - start);
+            responseBytes += AppendResponse(dialogue, fullName, connection.output);
+            ++requests;
+            start = end + 1;
+        }
+        connection.pending.erase(0, start);
+
+        return Flush(connection);
+    }
+
+    // Reads once from a readable connection and submits every name completed by the read to the
+    // batcher. The names are copied into the reader's arena, as the pending buffer moves on; the
+    // reader frees them once they have been answered. Returns false once the connection should be
+    // closed.
+    bool SubmitNames(AdaptiveBatcher& batcher, Connection& connection)
+    {
+        char data[READ_SIZE];
+        ssize_t received = recv(connection.fd, data, sizeof(data), 0);
+        if (received <= 0)
+        {
+            return received < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+
+        connection.pending.append(data, static_cast<size_t>(received));
+
+        BatchRequest request;
+        request.arrival = std::chrono::steady_clock::now();
+        request.tag = &connection;
+
+        size_t start = 0;
+        size_t end;
+        while ((end = connection.pending.find('\n', start)) != ThreadString::npos)
+        {
+            size_t length = end - start;
+            char* name = static_cast<char*>(ThreadArenaAllocator("FormatServer request").allocate(length > 0 ? length : 1));
+            memcpy(name, connection.pending.data() + start, length);
+            request.name = eastl::string_view(name, length);
+            ++connection.inFlight;
+            batcher.Submit(request);
+            start = end + 1;
+        }
+        connection.pending.erase(0, start);
+        return true;
+    }
+
+    // Frees a connection that is done, or if the batcher still has some of its requests, stops
+    // watching it and leaves it to be freed once they have been answered.
+    void RetireConnection(int epoll, eastl::vector<Connection*>& connections, Connection* connection)
+    {
+        if (connection->inFlight > 0)
+        {
+            epoll_ctl(epoll, EPOLL_CTL_DEL, connection->fd, nullptr);
+            connection->closing = true;
+            return;
+        }
+        RemoveConnection(connections, connection);
+        CloseConnection(connection);
+    }
+#endif
+}
+
+struct FormatServer::Shard
+{
+    unsigned index = 0;
+    int listener = -1;
+
+    // Set by the shard's thread once its catalog and event loop are ready, or have failed.
+    std::promise<bool> started;
+
+    // Written only by the shard's thread, and on a cache line of its own.
+    alignas(64) std::atomic<uint64_t> connections{ 0 };
+    std::atomic<uint64_t> requests{ 0 };
+    std::atomic<uint64_t> responseBytes{ 0 };
+};
+
+struct FormatServer::BatchedState
+{
+    int listener = -1;
+    int epoll = -1;
+    // Written by the batcher's thread to wake the reader once there are answers.
+    int answeredEvent = -1;
+    TemplateCatalog catalog;
+    const CompiledTemplate* dialogue = nullptr;
+    eastl::unique_ptr<AdaptiveBatcher> batcher;
+
+    // Only touched by the reader.
+    eastl::vector<Connection*> openConnections;
+
+    // Only touched by the batcher's thread.
+    eastl::string formatted;
+    eastl::vector<size_t> lengths;
+
+    // Answered requests waiting for the reader, in the order they were submitted, with their
+    // responses back to back in 'answeredOutput'.
+    std::mutex mutex;
+    eastl::vector<BatchRequest> answered;
+    eastl::vector<size_t> answeredLengths;
+    eastl::string answeredOutput;
+
+    // Written only by the reader.
+    std::atomic<uint64_t> connections{ 0 };
+    std::atomic<uint64_t> requests{ 0 };
+    std::atomic<uint64_t> responseBytes{ 0 };
+};
+
+struct FormatServer::SharedState
+{
+    int listener = -1;
+    int epoll = -1;
+    TemplateCatalog catalog;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    eastl::deque<Connection*> readyConnections;
+    eastl::vector<Connection*> openConnections;
+
+    // Every worker adds to these.
+    std::atomic<uint64_t> connections{ 0 };
+    std::atomic<uint64_t> requests{ 0 };
+    std::atomic<uint64_t> responseBytes{ 0 };
+};
+
+FormatServer::FormatServer(ServerMode mode, unsigned threadCount, eastl::string_view catalogText, const BatcherConfig& batching)
+    : mMode(mode), mThreadCount(threadCount > 0 ? threadCount : 1), mCatalogText(catalogText.data(), catalogText.length()),
+      mBatching(batching)
+{
+}
+
+FormatServer::~FormatServer()
+{
+    Stop();
+}
+
+bool FormatServer::Start(uint16_t port)
+{
+#if defined(__linux__)
+    if (!mThreads.empty())
+    {
+        return false;
+    }
+
+    // Every thread loads the same text, so a bad catalog is rejected here rather than per thread.
+    TemplateCatalog catalog;
+    if (!catalog.Load(mCatalogText) || catalog.Find(DIALOGUE_KEY) == nullptr)
+    {
+        return false;
+    }
+
+    mShards.clear();
+    mShared.reset();
+    mBatched.reset();
+    mStopping.store(false, std::memory_order_relaxed);
+    mStopEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (mStopEvent < 0)
+    {
+        return false;
+    }
+
+    if (mMode == ServerMode::ThreadPerCore)
+    {
+        // With port 0 the first listener picks a port and the others share it.
+        for (unsigned i = 0; i < mThreadCount; ++i)
+        {
+            eastl::unique_ptr<Shard> shard(new Shard());
+            shard->index = i;
+            shard->listener = OpenListener(port, true);
+            bool opened = shard->listener >= 0;
+            if (opened)
+            {
+                port = GetBoundPort(shard->listener);
+            }
+
+            mShards.push_back(eastl::move(shard));
+            if (!opened)
+            {
+                Stop();
+                return false;
+            }
+        }
+
+        // Each shard sets itself up on its own thread, so its memory is first touched on its core.
+        // A shard that fails would leave a listener the kernel still hands connections to, so
+        // Start() waits for every shard and fails if any of them did.
+        mPort = port;
+        eastl::vector<std::future<bool>> started;
+        for (eastl::unique_ptr<Shard>& shard : mShards)
+        {
+            Shard* owned = shard.get();
+            started.push_back(owned->started.get_future());
+            mThreads.push_back(std::thread([this, owned] { RunShard(*owned); }));
+        }
+
+        bool ready = true;
+        for (std::future<bool>& shardStarted : started)
+        {
+            ready = shardStarted.get() && ready;
+        }
+        if (!ready)
+        {
+            Stop();
+            return false;
+        }
+    }
+    else if (mMode == ServerMode::Batched)
+    {
+        mBatched.reset(new BatchedState());
+        BatchedState& batched = *mBatched;
+        batched.listener = OpenListener(port, false);
+        batched.epoll = epoll_create1(EPOLL_CLOEXEC);
+        batched.answeredEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        batched.dialogue = batched.catalog.Load(mCatalogText) ? batched.catalog.Find(DIALOGUE_KEY) : nullptr;
+        if (batched.listener < 0 || batched.epoll < 0 || batched.answeredEvent < 0 || batched.dialogue == nullptr ||
+            !AddToEpoll(batched.epoll, batched.listener, EPOLLIN, &batched.listener) ||
+            !AddToEpoll(batched.epoll, batched.answeredEvent, EPOLLIN, &batched.answeredEvent) ||
+            !AddToEpoll(batched.epoll, mStopEvent, EPOLLIN, &mStopEvent))
+        {
+            Stop();
+            return false;
+        }
+
+        mPort = GetBoundPort(batched.listener);
+        batched.batcher.reset(new AdaptiveBatcher(mBatching, HandleBatch, &batched));
+        batched.batcher->Start();
+        mThreads.push_back(std::thread([this] { RunReader(); }));
+    }
+    else
+    {
+        mShared.reset(new SharedState());
+        mShared->listener = OpenListener(port, false);
+        mShared->epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (mShared->listener < 0 || mShared->epoll < 0 || !mShared->catalog.Load(mCatalogText) ||
+            !AddToEpoll(mShared->epoll, mShared->listener, EPOLLIN, &mShared->listener) ||
+            !AddToEpoll(mShared->epoll, mStopEvent, EPOLLIN, &mStopEvent))
+        {
+            Stop();
+            return false;
+        }
+
+        mPort = GetBoundPort(mShared->listener);
+        mThreads.push_back(std::thread([this] { RunAcceptor(); }));
+        for (unsigned i = 0; i < mThreadCount; ++i)
+        {
+            mThreads.push_back(std::thread([this] { RunWorker(); }));
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FormatServer::Stop()
+{
+#if defined(__linux__)
+    mStopping.store(true, std::memory_order_release);
+    if (mStopEvent >= 0)
+    {
+        uint64_t one = 1;
+        ssize_t written = write(mStopEvent, &one, sizeof(one));
+        (void)written;
+    }
+    if (mShared)
+    {
+        std::lock_guard<std::mutex> lock(mShared->mutex);
+        mShared->ready.notify_all();
+    }
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+    mThreads.clear();
+
+    // Shards close their own connections on the way out. Stats stay readable until the next Start().
+    for (eastl::unique_ptr<Shard>& shard : mShards)
+    {
+        if (shard->listener >= 0)
+        {
+            close(shard->listener);
+            shard->listener = -1;
+        }
+    }
+
+    if (mShared)
+    {
+        for (Connection* connection : mShared->openConnections)
+        {
+            CloseConnection(connection);
+        }
+        mShared->openConnections.clear();
+        mShared->readyConnections.clear();
+
+        if (mShared->listener >= 0)
+        {
+            close(mShared->listener);
+            mShared->listener = -1;
+        }
+        if (mShared->epoll >= 0)
+        {
+            close(mShared->epoll);
+            mShared->epoll = -1;
+        }
+    }
+
+    if (mBatched)
+    {
+        // Answers every request already submitted. The reader has gone, so they are only freed.
+        if (mBatched->batcher)
+        {
+            mBatched->batcher->Stop();
+        }
+        for (const BatchRequest& request : mBatched->answered)
+        {
+            ThreadArena::Free(const_cast<char*>(request.name.data()));
+        }
+        mBatched->answered.clear();
+        mBatched->answeredLengths.clear();
+        mBatched->answeredOutput.clear();
+
+        for (Connection* connection : mBatched->openConnections)
+        {
+            CloseConnection(connection);
+        }
+        mBatched->openConnections.clear();
+
+        for (int* fd : { &mBatched->listener, &mBatched->epoll, &mBatched->answeredEvent })
+        {
+            if (*fd >= 0)
+            {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    if (mStopEvent >= 0)
+    {
+        close(mStopEvent);
+        mStopEvent = -1;
+    }
+#endif
+}
+
+ServerStats FormatServer::GetStats() const
+{
+    ServerStats stats = {};
+    for (const eastl::unique_ptr<Shard>& shard : mShards)
+    {
+        stats.connections += shard->connections.load(std::memory_order_relaxed);
+        stats.requests += shard->requests.load(std::memory_order_relaxed);
+        stats.responseBytes += shard->responseBytes.load(std::memory_order_relaxed);
+    }
+    if (mShared)
+    {
+        stats.connections += mShared->connections.load(std::memory_order_relaxed);
+        stats.requests += mShared->requests.load(std::memory_order_relaxed);
+        stats.responseBytes += mShared->responseBytes.load(std::memory_order_relaxed);
+    }
+    if (mBatched)
+    {
+        stats.connections += mBatched->connections.load(std::memory_order_relaxed);
+        stats.requests += mBatched->requests.load(std::memory_order_relaxed);
+        stats.responseBytes += mBatched->responseBytes.load(std::memory_order_relaxed);
+        if (mBatched->batcher)
+        {
+            BatcherStats batcherStats = mBatched->batcher->GetStats();
+            stats.batches = batcherStats.batches;
+            stats.batchLimit = batcherStats.batchLimit;
+        }
+    }
+    return stats;
+}
+
+const char* FormatServer::GetModeName(ServerMode mode)
+{
+    switch (mode)
+    {
+    case ServerMode::ThreadPerCore: return "thread per core";
+    case ServerMode::Batched: return "reader + adaptive batcher";
+    default: return "shared acceptor + workers";
+    }
+}
+
+void FormatServer::RunShard(Shard& shard)
+{
+#if defined(__linux__)
+    PinToCore(shard.index);
+
+    // The shard's own copy of the catalog, with the template looked up once for the shard's lifetime.
+    TemplateCatalog catalog;
+    catalog.Load(mCatalogText);
+    const CompiledTemplate* dialogue = catalog.Find(DIALOGUE_KEY);
+
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    bool running = dialogue != nullptr && epoll >= 0 &&
+        AddToEpoll(epoll, shard.listener, EPOLLIN, &shard.listener) &&
+        AddToEpoll(epoll, mStopEvent, EPOLLIN, &mStopEvent);
+    shard.started.set_value(running);
+
+    eastl::vector<Connection*> connections;
+    epoll_event events[MAX_EVENTS];
+    while (running)
+    {
+        int eventCount = epoll_wait(epoll, events, MAX_EVENTS, -1);
+        for (int i = 0; i < eventCount; ++i)
+        {
+            void* data = events[i].data.ptr;
+            if (data == &mStopEvent)
+            {
+                running = false;
+            }
+            else if (data == &shard.listener)
+            {
+                int fd;
+                while ((fd = accept4(shard.listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+                {
+                    Connection* connection = OpenConnection(fd);
+                    if (!WatchConnection(epoll, EPOLL_CTL_ADD, *connection, 0))
+                    {
+                        CloseConnection(connection);
+                        continue;
+                    }
+                    connection->slot = connections.size();
+                    connections.push_back(connection);
+                    AddLocal(shard.connections, 1);
+                }
+            }
+            else
+            {
+                Connection* connection = static_cast<Connection*>(data);
+                uint64_t requests = 0;
+                uint64_t responseBytes = 0;
+                bool wasWriting = connection->writing;
+                bool open = Serve(*dialogue, *connection, requests, responseBytes);
+                AddLocal(shard.requests, requests);
+                AddLocal(shard.responseBytes, responseBytes);
+                if (open && connection->writing != wasWriting)
+                {
+                    open = WatchConnection(epoll, EPOLL_CTL_MOD, *connection, 0);
+                }
+                if (!open)
+                {
+                    RemoveConnection(connections, connection);
+                    CloseConnection(connection);
+                }
+            }
+        }
+    }
+
+    for (Connection* connection : connections)
+    {
+        CloseConnection(connection);
+    }
+    if (epoll >= 0)
+    {
+        close(epoll);
+    }
+#endif
+}
+
+void FormatServer::RunAcceptor()
+{
+#if defined(__linux__)
+    SharedState& shared = *mShared;
+    bool running = true;
+
+    epoll_event events[MAX_EVENTS];
+    while (running)
+    {
+        int eventCount = epoll_wait(shared.epoll, events, MAX_EVENTS, -1);
+        for (int i = 0; i < eventCount; ++i)
+        {
+            void* data = events[i].data.ptr;
+            if (data == &mStopEvent)
+            {
+                running = false;
+            }
+            else if (data == &shared.listener)
+            {
+                int fd;
+                while ((fd = accept4(shared.listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+                {
+                    Connection* connection = OpenConnection(fd);
+                    {
+                        std::lock_guard<std::mutex> lock(shared.mutex);
+                        connection->slot = shared.openConnections.size();
+                        shared.openConnections.push_back(connection);
+                    }
+                    // One-shot, so a connection is with at most one worker at a time and its
+                    // responses stay in order. The worker re-arms it.
+                    if (!WatchConnection(shared.epoll, EPOLL_CTL_ADD, *connection, EPOLLONESHOT))
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(shared.mutex);
+                            RemoveConnection(shared.openConnections, connection);
+                        }
+                        CloseConnection(connection);
+                        continue;
+                    }
+                    shared.connections.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else
+            {
+                {
+                    std::lock_guard<std::mutex> lock(shared.mutex);
+                    shared.readyConnections.push_back(static_cast<Connection*>(data));
+                }
+                shared.ready.notify_one();
+            }
+        }
+    }
+#endif
+}
+
+void FormatServer::RunWorker()
+{
+#if defined(__linux__)
+    SharedState& shared = *mShared;
+    const CompiledTemplate* dialogue = shared.catalog.Find(DIALOGUE_KEY);
+
+    for (;;)
+    {
+        Connection* connection;
+        {
+            std::unique_lock<std::mutex> lock(shared.mutex);
+            shared.ready.wait(lock, [&] { return !shared.readyConnections.empty() || mStopping.load(std::memory_order_acquire); });
+            if (mStopping.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            connection = shared.readyConnections.front();
+            shared.readyConnections.pop_front();
+        }
+
+        uint64_t requests = 0;
+        uint64_t responseBytes = 0;
+        bool open = Serve(*dialogue, *connection, requests, responseBytes);
+        shared.requests.fetch_add(requests, std::memory_order_relaxed);
+        shared.responseBytes.fetch_add(responseBytes, std::memory_order_relaxed);
+
+        // Re-arming is what hands the connection on; the next worker to take it sees this one's writes.
+        if (!open || !WatchConnection(shared.epoll, EPOLL_CTL_MOD, *connection, EPOLLONESHOT))
+        {
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                RemoveConnection(shared.openConnections, connection);
+            }
+            CloseConnection(connection);
+        }
+    }
+#endif
+}
+
+void FormatServer::RunReader()
+{
+#if defined(__linux__)
+    BatchedState& batched = *mBatched;
+
+    // Swapped with the batcher's lists, so their capacity is reused.
+    eastl::vector<BatchRequest> answered;
+    eastl::vector<size_t> answeredLengths;
+    eastl::string answeredOutput;
+    eastl::vector<Connection*> flushes;
+
+    bool running = true;
+    epoll_event events[MAX_EVENTS];
+    while (running)
+    {
+        int eventCount = epoll_wait(batched.epoll, events, MAX_EVENTS, -1);
+        for (int i = 0; i < eventCount; ++i)
+        {
+            void* data = events[i].data.ptr;
+            if (data == &mStopEvent)
+            {
+                running = false;
+            }
+            else if (data == &batched.listener)
+            {
+                int fd;
+                while ((fd = accept4(batched.listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+                {
+                    Connection* connection = OpenConnection(fd);
+                    if (!WatchConnection(batched.epoll, EPOLL_CTL_ADD, *connection, 0))
+                    {
+                        CloseConnection(connection);
+                        continue;
+                    }
+                    connection->slot = batched.openConnections.size();
+                    batched.openConnections.push_back(connection);
+                    AddLocal(batched.connections, 1);
+                }
+            }
+            else if (data == &batched.answeredEvent)
+            {
+                // Read before taking the answers, so answers added after this wake the reader again.
+                uint64_t count;
+                ssize_t readBytes = read(batched.answeredEvent, &count, sizeof(count));
+                (void)readBytes;
+                {
+                    std::lock_guard<std::mutex> lock(batched.mutex);
+                    answered.swap(batched.answered);
+                    answeredLengths.swap(batched.answeredLengths);
+                    answeredOutput.swap(batched.answeredOutput);
+                }
+
+                // Gather each connection's answers, then send them with one write per connection.
+                size_t offset = 0;
+                for (size_t a = 0; a < answered.size(); ++a)
+                {
+                    Connection* connection = static_cast<Connection*>(answered[a].tag);
+                    ThreadArena::Free(const_cast<char*>(answered[a].name.data()));
+                    --connection->inFlight;
+                    if (!connection->closing)
+                    {
+                        connection->output.append(answeredOutput.data() + offset, answeredLengths[a]);
+                        if (!connection->flushQueued)
+                        {
+                            connection->flushQueued = true;
+                            flushes.push_back(connection);
+                        }
+                    }
+                    else if (connection->inFlight == 0)
+                    {
+                        RetireConnection(batched.epoll, batched.openConnections, connection);
+                    }
+                    offset += answeredLengths[a];
+                }
+                AddLocal(batched.requests, answered.size());
+                AddLocal(batched.responseBytes, offset);
+                answered.clear();
+                answeredLengths.clear();
+                answeredOutput.clear();
+
+                for (Connection* connection : flushes)
+                {
+                    connection->flushQueued = false;
+                    bool wasWriting = connection->writing;
+                    bool open = Flush(*connection);
+                    if (open && connection->writing != wasWriting)
+                    {
+                        open = WatchConnection(batched.epoll, EPOLL_CTL_MOD, *connection, 0);
+                    }
+                    if (!open)
+                    {
+                        RetireConnection(batched.epoll, batched.openConnections, connection);
+                    }
+                }
+                flushes.clear();
+            }
+            else
+            {
+                Connection* connection = static_cast<Connection*>(data);
+                bool wasWriting = connection->writing;
+                bool open = connection->writing ? Flush(*connection) : SubmitNames(*batched.batcher, *connection);
+                if (open && connection->writing != wasWriting)
+                {
+                    open = WatchConnection(batched.epoll, EPOLL_CTL_MOD, *connection, 0);
+                }
+                if (!open)
+                {
+                    RetireConnection(batched.epoll, batched.openConnections, connection);
+                }
+            }
+        }
+    }
+#endif
+}
+
+void FormatServer::HandleBatch(const BatchRequest* requests, size_t count, void* context)
+{
+#if defined(__linux__)
+    BatchedState& batched = *static_cast<BatchedState*>(context);
+    batched.formatted.clear();
+    batched.lengths.resize(count);
+    FormatBatch(*batched.dialogue, requests, count, batched.formatted, batched.lengths.data());
+
+    // The reader takes every answer each time it wakes, so only the first batch since then wakes it.
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(batched.mutex);
+        wake = batched.answered.empty();
+        batched.answered.insert(batched.answered.end(), requests, requests + count);
+        batched.answeredLengths.insert(batched.answeredLengths.end(), batched.lengths.begin(), batched.lengths.end());
+        batched.answeredOutput.append(batched.formatted);
+    }
+    if (wake)
+    {
+        uint64_t one = 1;
+        ssize_t written = write(batched.answeredEvent, &one, sizeof(one));
+        (void)written;
+    }
+#endif
+}
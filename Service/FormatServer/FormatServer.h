@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+#include "AdaptiveBatcher.h"
+
+enum class ServerMode
+{
+    // One thread accepts connections and waits for requests on all of them. Ready connections go
+    // through a shared queue to a pool of worker threads, which share the catalog and the stats.
+    SharedAcceptor,
+    // Every thread is pinned to a core and owns a SO_REUSEPORT listener, an event loop, a catalog,
+    // an arena for its connections and its stats. The kernel spreads connections across the
+    // listeners and the threads never touch each other's memory.
+    ThreadPerCore,
+    // One thread reads every connection and submits each name to an AdaptiveBatcher. The
+    // batcher's thread formats a batch at a time with FormatBatch and hands the answers back to
+    // the reader, which sends each connection's share of a batch with one write.
+    Batched
+};
+
+struct ServerStats
+{
+    uint64_t connections;
+    uint64_t requests;
+    uint64_t responseBytes;
+    // Batched mode only.
+    uint64_t batches;
+    size_t batchLimit;
+};
+
+// A local TCP server that answers every newline terminated name it receives with MOE_DIALOGUE_1
+// from a template catalog, formatted for that name, in order. Listens on 127.0.0.1 only.
+//
+// In SharedAcceptor mode 'threadCount' is the number of workers, plus one acceptor thread. In
+// Batched mode it is unused, as there is always one reader and the batcher's thread. Linux
+// only, as it relies on epoll and SO_REUSEPORT; Start() fails on other platforms.
+class FormatServer
+{
+public:
+    // 'catalogText' is loaded as a TemplateCatalog and must contain MOE_DIALOGUE_1. 'batching'
+    // configures the batcher in Batched mode.
+    FormatServer(ServerMode mode, unsigned threadCount, eastl::string_view catalogText,
+        const BatcherConfig& batching = BatcherConfig());
+    ~FormatServer();
+
+    FormatServer(const FormatServer&) = delete;
+    FormatServer& operator=(const FormatServer&) = delete;
+
+    // Listens on 'port', or on an ephemeral port if it is 0, and starts the threads. Fails, with
+    // nothing left running, unless every thread set itself up.
+    bool Start(uint16_t port = 0);
+
+    // Stops the threads and closes every connection.
+    void Stop();
+
+    uint16_t GetPort() const { return mPort; }
+    ServerStats GetStats() const;
+
+    static const char* GetModeName(ServerMode mode);
+
+private:
+    struct Shard;
+    struct SharedState;
+    struct BatchedState;
+
+    void RunShard(Shard& shard);
+    void RunAcceptor();
+    void RunWorker();
+    void RunReader();
+
+    static void HandleBatch(const BatchRequest* requests, size_t count, void* context);
+
+    ServerMode mMode;
+    unsigned mThreadCount;
+    eastl::string mCatalogText;
+    BatcherConfig mBatching;
+    uint16_t mPort = 0;
+
+    // Written to once to wake every event loop for shutdown.
+    int mStopEvent = -1;
+    std::atomic<bool> mStopping{ false };
+
+    eastl::vector<eastl::unique_ptr<Shard>> mShards;
+    eastl::unique_ptr<SharedState> mShared;
+    eastl::unique_ptr<BatchedState> mBatched;
+    eastl::vector<std::thread> mThreads;
+};
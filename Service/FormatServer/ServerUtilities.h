@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+#include "TemplateFormat.h"
+
+// Helpers shared by FormatServer and AdaptiveBatcher.
+
+// Most responses fit, so they are formatted in place first and only reformatted when they do not.
+constexpr size_t RESPONSE_CAPACITY = 256;
+
+// A counter with a single writer needs no read-modify-write, only a value other threads can read.
+inline void AddLocal(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline eastl::string_view FirstName(eastl::string_view fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    return delimiterPosition != eastl::string_view::npos ? fullName.substr(0, delimiterPosition) : fullName;
+}
+
+// Formats MOE_DIALOGUE_1 for 'fullName' onto the end of 'output', however long the name makes it.
+// Returns the number of bytes appended.
+template <typename String>
+size_t AppendResponse(const CompiledTemplate& dialogue, eastl::string_view fullName, String& output)
+{
+    size_t offset = output.length();
+    output.resize(offset + RESPONSE_CAPACITY);
+    size_t length = FormatTemplate(dialogue, { FirstName(fullName), fullName }, &output[offset], RESPONSE_CAPACITY);
+    if (length >= RESPONSE_CAPACITY)
+    {
+        output.resize(offset + length + 1);
+        FormatTemplate(dialogue, { FirstName(fullName), fullName }, &output[offset], length + 1);
+    }
+    output.resize(offset + length);
+    return length;
+}
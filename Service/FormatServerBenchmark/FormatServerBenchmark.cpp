@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "FormatServer.h"
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr eastl::string_view CATALOG =
+    "MOE_DIALOGUE_1=Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\\n\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// Names a client sends before waiting for their answers. Small enough that neither side's socket
+// buffer fills while the other is still sending.
+constexpr size_t BATCH_SIZE = 16;
+
+struct ClientResult
+{
+    uint64_t requests = 0;
+    uint64_t batches = 0;
+    double batchNanoseconds = 0;
+    bool failed = false;
+};
+
+#if defined(__linux__)
+int Connect(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Sends 'batchCount' batches of names on one connection, waiting for every answer in a batch
+// before sending the next.
+void RunClient(uint16_t port, size_t clientIndex, size_t batchCount, ClientResult& result)
+{
+    int fd = Connect(port);
+    if (fd < 0)
+    {
+        result.failed = true;
+        return;
+    }
+
+    eastl::string batch;
+    char buffer[16 * 1024];
+    for (size_t b = 0; b < batchCount && !result.failed; ++b)
+    {
+        batch.clear();
+        for (size_t i = 0; i < BATCH_SIZE; ++i)
+        {
+            size_t index = (clientIndex * batchCount + b) * BATCH_SIZE + i;
+            char name[64];
+            int length = snprintf(name, sizeof(name), "%s%zu %s of Springfield\n", FIRST_NAMES[index % 10], index, SURNAMES[(index / 10) % 10]);
+            batch.append(name, length > 0 ? static_cast<size_t>(length) : 0);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (send(fd, batch.data(), batch.length(), MSG_NOSIGNAL) != static_cast<ssize_t>(batch.length()))
+        {
+            result.failed = true;
+            break;
+        }
+
+        size_t answered = 0;
+        while (answered < BATCH_SIZE)
+        {
+            ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received <= 0)
+            {
+                result.failed = true;
+                break;
+            }
+            answered += static_cast<size_t>(std::count(buffer, buffer + received, '\n'));
+        }
+
+        result.batchNanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        result.requests += answered;
+        ++result.batches;
+    }
+    close(fd);
+}
+#endif
+
+bool RunMode(ServerMode mode, unsigned threadCount, size_t connectionCount, size_t batchCount)
+{
+#if defined(__linux__)
+    FormatServer server(mode, threadCount, CATALOG);
+    if (!server.Start())
+    {
+        printf("%s: failed to start\n", FormatServer::GetModeName(mode));
+        return false;
+    }
+
+    eastl::vector<ClientResult> results(connectionCount);
+    eastl::vector<std::thread> clients;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < connectionCount; ++i)
+    {
+        clients.push_back(std::thread(RunClient, server.GetPort(), i, batchCount, std::ref(results[i])));
+    }
+    for (std::thread& client : clients)
+    {
+        client.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    server.Stop();
+
+    ClientResult total;
+    for (const ClientResult& result : results)
+    {
+        total.requests += result.requests;
+        total.batches += result.batches;
+        total.batchNanoseconds += result.batchNanoseconds;
+        total.failed |= result.failed;
+    }
+
+    ServerStats stats = server.GetStats();
+    printf("%-44s %8.1f ms  %9.0f requests/s  %6.1f us/batch\n", FormatServer::GetModeName(mode), seconds * 1e3,
+        static_cast<double>(total.requests) / seconds,
+        total.batches > 0 ? total.batchNanoseconds / static_cast<double>(total.batches) / 1e3 : 0.0);
+    printf("%-44s %zu connections, %zu requests, %zu KB answered%s\n", "", static_cast<size_t>(stats.connections),
+        static_cast<size_t>(stats.requests), static_cast<size_t>(stats.responseBytes / 1024), total.failed ? ", CLIENT ERRORS" : "");
+    if (stats.batches > 0)
+    {
+        printf("%-44s %.1f requests per batch, batch limit %zu\n", "", static_cast<double>(stats.requests) / static_cast<double>(stats.batches),
+            stats.batchLimit);
+    }
+    return !total.failed;
+#else
+    return false;
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    unsigned threadCount = argc > 1 ? static_cast<unsigned>(strtoul(argv[1], nullptr, 10)) : std::max(1u, std::thread::hardware_concurrency());
+    size_t connectionCount = argc > 2 ? strtoull(argv[2], nullptr, 10) : 32;
+    size_t batchCount = argc > 3 ? strtoull(argv[3], nullptr, 10) : 2000;
+    if (threadCount == 0 || connectionCount == 0 || batchCount == 0)
+    {
+        printf("Usage: FormatServerBenchmark [threads] [connections] [batchesPerConnection]\n");
+        return 1;
+    }
+
+#if defined(__linux__)
+    printf("%u server threads, %zu connections, %zu batches of %zu names each\n", threadCount, connectionCount, batchCount, BATCH_SIZE);
+
+    bool passed = RunMode(ServerMode::SharedAcceptor, threadCount, connectionCount, batchCount);
+    passed &= RunMode(ServerMode::ThreadPerCore, threadCount, connectionCount, batchCount);
+    passed &= RunMode(ServerMode::Batched, threadCount, connectionCount, batchCount);
+    return passed ? 0 : 1;
+#else
+    printf("FormatServerBenchmark needs epoll and SO_REUSEPORT, which are Linux only\n");
+    return 1;
+#endif
+}
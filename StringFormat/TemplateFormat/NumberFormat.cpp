@@ -0,0 +1,80 @@
+#include "NumberFormat.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace
+{
+    constexpr char DIGIT_PAIRS[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+}
+
+uint32_t CountDigits(uint64_t value)
+{
+    uint32_t digits = 1;
+    for (;;)
+    {
+        if (value < 10) return digits;
+        if (value < 100) return digits + 1;
+        if (value < 1000) return digits + 2;
+        if (value < 10000) return digits + 3;
+        value /= 10000;
+        digits += 4;
+    }
+}
+
+char* FormatUnsigned(uint64_t value, char* out)
+{
+    char* end = out + CountDigits(value);
+    char* cursor = end;
+
+    while (value >= 100)
+    {
+        size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        cursor -= 2;
+        memcpy(cursor, DIGIT_PAIRS + pair, 2);
+    }
+
+    if (value >= 10)
+    {
+        memcpy(cursor - 2, DIGIT_PAIRS + value * 2, 2);
+    }
+    else
+    {
+        cursor[-1] = static_cast<char>('0' + value);
+    }
+
+    return end;
+}
+
+char* FormatSigned(int64_t value, char* out)
+{
+    uint64_t magnitude = static_cast<uint64_t>(value);
+    if (value < 0)
+    {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+
+    return FormatUnsigned(magnitude, out);
+}
+
+char* FormatDouble(double value, char* out)
+{
+    return std::to_chars(out, out + MAX_DOUBLE_LENGTH, value).ptr;
+}
+
+char* FormatFixed(double value, int precision, char* out)
+{
+    return std::to_chars(out, out + MAX_FIXED_LENGTH, value, std::chars_format::fixed, precision).ptr;
+}
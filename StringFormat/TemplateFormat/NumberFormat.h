@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Upper bounds on the number of characters written by each routine. Callers that have at least
+// this much space left can format straight into their output buffer.
+constexpr size_t MAX_INTEGER_LENGTH = 20;
+constexpr size_t MAX_DOUBLE_LENGTH = 24;
+constexpr int MAX_FIXED_PRECISION = 17;
+constexpr size_t MAX_FIXED_LENGTH = 1 + 309 + 1 + MAX_FIXED_PRECISION;
+
+uint32_t CountDigits(uint64_t value);
+
+// Each routine writes to 'out' without a null terminator and returns one past the last character.
+char* FormatUnsigned(uint64_t value, char* out);
+char* FormatSigned(int64_t value, char* out);
+
+// Shortest representation that parses back to exactly the same double.
+char* FormatDouble(double value, char* out);
+
+// Fixed notation with 'precision' digits after the decimal point, as printf's "%.Nf".
+char* FormatFixed(double value, int precision, char* out);
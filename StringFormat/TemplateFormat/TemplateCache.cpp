@@ -0,0 +1,142 @@
+#include "TemplateCache.h"
+
+#include <cstdint>
+
+TemplateCache::TemplateCache(size_t capacity, PluralRule rule) : mPluralRule(rule)
+{
+    size_t slotCount = PROBE_LIMIT;
+    while (slotCount < capacity)
+    {
+        slotCount *= 2;
+    }
+
+    mSlots.reset(new std::atomic<Entry*>[slotCount]);
+    for (size_t i = 0; i < slotCount; ++i)
+    {
+        mSlots[i].store(nullptr, std::memory_order_relaxed);
+    }
+    mSlotMask = slotCount - 1;
+}
+
+TemplateCache::~TemplateCache()
+{
+    for (size_t i = 0; i <= mSlotMask; ++i)
+    {
+        delete mSlots[i].load(std::memory_order_relaxed);
+    }
+}
+
+size_t TemplateCache::GetHomeSlot(eastl::string_view source) const
+{
+    uint64_t hash = reinterpret_cast<uintptr_t>(source.data()) ^ (static_cast<uint64_t>(source.length()) << 48);
+    hash *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 32) & mSlotMask;
+}
+
+const TemplateCache::Entry* TemplateCache::Find(eastl::string_view source) const
+{
+    size_t home = GetHomeSlot(source);
+    for (size_t probe = 0; probe < PROBE_LIMIT; ++probe)
+    {
+        const Entry* entry = mSlots[(home + probe) & mSlotMask].load(std::memory_order_acquire);
+        if (entry != nullptr && entry->data == source.data() && entry->length == source.length())
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+const TemplateCache::Entry* TemplateCache::Insert(eastl::string_view source)
+{
+    Entry* entry = new Entry{ source.data(), source.length(), false, CompiledTemplate() };
+    entry->valid = CompileTemplate(source, entry->compiled, mPluralRule);
+
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+
+    // Another thread may have compiled the same template while this one was.
+    if (const Entry* existing = Find(source))
+    {
+        delete entry;
+        return existing;
+    }
+
+    size_t home = GetHomeSlot(source);
+    for (size_t probe = 0; probe < PROBE_LIMIT; ++probe)
+    {
+        std::atomic<Entry*>& slot = mSlots[(home + probe) & mSlotMask];
+        if (slot.load(std::memory_order_relaxed) == nullptr)
+        {
+            slot.store(entry, std::memory_order_release);
+            return entry;
+        }
+    }
+
+    std::atomic<Entry*>& victim = mSlots[(home + mEvictionCursor++ % PROBE_LIMIT) & mSlotMask];
+    mEpochs.Retire(victim.exchange(entry, std::memory_order_acq_rel));
+    return entry;
+}
+
+size_t TemplateCache::Format(eastl::string_view source, const TemplateArg* args, size_t argCount,
+    char* buffer, size_t capacity)
+{
+    EpochDomain::Guard guard(mEpochs);
+
+    const Entry* entry = Find(source);
+    if (mLookupHook != nullptr)
+    {
+        mLookupHook(entry != nullptr, mLookupContext);
+    }
+    if (entry == nullptr)
+    {
+        entry = Insert(source);
+    }
+
+    if (!entry->valid)
+    {
+        if (capacity > 0)
+        {
+            buffer[0] = '\0';
+        }
+        return 0;
+    }
+
+    return FormatTemplate(entry->compiled, args, argCount, buffer, capacity);
+}
+
+void TemplateCache::Invalidate(eastl::string_view source)
+{
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+
+    size_t home = GetHomeSlot(source);
+    for (size_t probe = 0; probe < PROBE_LIMIT; ++probe)
+    {
+        std::atomic<Entry*>& slot = mSlots[(home + probe) & mSlotMask];
+        Entry* entry = slot.load(std::memory_order_relaxed);
+        if (entry != nullptr && entry->data == source.data() && entry->length == source.length())
+        {
+            slot.store(nullptr, std::memory_order_release);
+            mEpochs.Retire(entry);
+            return;
+        }
+    }
+}
+
+void TemplateCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+
+    for (size_t i = 0; i <= mSlotMask; ++i)
+    {
+        if (Entry* entry = mSlots[i].exchange(nullptr, std::memory_order_acq_rel))
+        {
+            mEpochs.Retire(entry);
+        }
+    }
+}
+
+TemplateCache& GetTemplateCache()
+{
+    static TemplateCache cache;
+    return cache;
+}
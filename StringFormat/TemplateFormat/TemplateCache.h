@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <EASTL/unique_ptr.h>
+#include "EpochDomain.h"
+#include "TemplateFormat.h"
+
+// Called on the formatting thread for every lookup, with whether the template was already cached.
+typedef void (*TemplateCacheLookupHook)(bool hit, void* context);
+
+// Compiled templates for template text that is only known at run time, keyed by the identity
+// (address and length) of the text. The first format of a template compiles it and later formats
+// reuse the result. Lookups are lock-free: a hit is a hash, a few atomic loads and an epoch pin.
+// 'capacity' is rounded up to a power of two of at least 8 slots, so the cache can hold a few
+// more templates than asked for (see GetCapacity()). It evicts within a template's probe window
+// when that window is full.
+//
+// Identity keys mean the template text must stay alive and unchanged while it is in the cache,
+// as is the case for templates owned by a loaded configuration. Call Invalidate() or Clear()
+// before freeing or rewriting template text.
+class TemplateCache
+{
+public:
+    explicit TemplateCache(size_t capacity = 1024, PluralRule rule = EnglishPluralRule);
+    ~TemplateCache();
+
+    TemplateCache(const TemplateCache&) = delete;
+    TemplateCache& operator=(const TemplateCache&) = delete;
+
+    // As FormatTemplate(). Templates that fail to compile are cached too and format as an empty
+    // string.
+    size_t Format(eastl::string_view source, const TemplateArg* args, size_t argCount, char* buffer, size_t capacity);
+
+    size_t Format(eastl::string_view source, std::initializer_list<TemplateArg> args, char* buffer, size_t capacity)
+    {
+        return Format(source, args.begin(), args.size(), buffer, capacity);
+    }
+
+    void Invalidate(eastl::string_view source);
+    void Clear();
+
+    size_t GetCapacity() const { return mSlotMask + 1; }
+
+    // Reports every lookup to 'hook', eg. CountCacheLookup() from the Stats library, or stops
+    // reporting if it is null, which is the default and costs a single branch. Not synchronised:
+    // set it before other threads format through the cache.
+    void SetLookupHook(TemplateCacheLookupHook hook, void* context)
+    {
+        mLookupHook = hook;
+        mLookupContext = context;
+    }
+
+private:
+    static constexpr size_t PROBE_LIMIT = 8;
+
+    struct Entry
+    {
+        const char* data;
+        size_t length;
+        bool valid;
+        CompiledTemplate compiled;
+    };
+
+    size_t GetHomeSlot(eastl::string_view source) const;
+    const Entry* Find(eastl::string_view source) const;
+    const Entry* Insert(eastl::string_view source);
+
+    eastl::unique_ptr<std::atomic<Entry*>[]> mSlots;
+    size_t mSlotMask;
+    PluralRule mPluralRule;
+
+    std::mutex mWriteMutex;
+    size_t mEvictionCursor = 0;
+    EpochDomain mEpochs;
+
+    TemplateCacheLookupHook mLookupHook = nullptr;
+    void* mLookupContext = nullptr;
+};
+
+// The process-wide cache used by FormatCachedTemplate().
+TemplateCache& GetTemplateCache();
+
+inline size_t FormatCachedTemplate(eastl::string_view source, std::initializer_list<TemplateArg> args,
+    char* buffer, size_t capacity)
+{
+    return GetTemplateCache().Format(source, args, buffer, capacity);
+}
@@ -0,0 +1,96 @@
+#include "TemplateCatalog.h"
+
+#include <EASTL/utility.h>
+
+namespace
+{
+    eastl::string_view Trim(eastl::string_view text)
+    {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '\r'))
+        {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+        {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    bool Unescape(eastl::string_view text, eastl::string& unescaped)
+    {
+        unescaped.clear();
+        for (size_t i = 0; i < text.length(); ++i)
+        {
+            if (text[i] != '\\')
+            {
+                unescaped.push_back(text[i]);
+                continue;
+            }
+
+            if (++i == text.length())
+            {
+                return false;
+            }
+
+            switch (text[i])
+            {
+            case 'n': unescaped.push_back('\n'); break;
+            case 't': unescaped.push_back('\t'); break;
+            case '\\': unescaped.push_back('\\'); break;
+            default: return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool TemplateCatalog::Add(eastl::string_view key, eastl::string_view source)
+{
+    CompiledTemplate compiled;
+    if (key.empty() || !CompileTemplate(source, compiled, mPluralRule))
+    {
+        return false;
+    }
+
+    mTemplates[eastl::string(key.data(), key.length())] = eastl::move(compiled);
+    return true;
+}
+
+bool TemplateCatalog::Load(eastl::string_view text)
+{
+    eastl::string source;
+    while (!text.empty())
+    {
+        size_t lineEnd = text.find('\n');
+        eastl::string_view line = text.substr(0, lineEnd);
+        text.remove_prefix(lineEnd != eastl::string_view::npos ? lineEnd + 1 : text.length());
+
+        // Only trailing carriage returns are stripped from templates; other whitespace is content.
+        while (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+
+        eastl::string_view trimmed = Trim(line);
+        if (trimmed.empty() || trimmed.front() == '#')
+        {
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        if (separator == eastl::string_view::npos ||
+            !Unescape(line.substr(separator + 1), source) ||
+            !Add(Trim(line.substr(0, separator)), source))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const CompiledTemplate* TemplateCatalog::Find(eastl::string_view key) const
+{
+    auto it = mTemplates.find_as(key, eastl::hash<eastl::string_view>(), eastl::equal_to_2<eastl::string, eastl::string_view>());
+    return it != mTemplates.end() ? &it->second : nullptr;
+}
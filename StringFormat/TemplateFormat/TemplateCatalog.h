@@ -0,0 +1,30 @@
+#pragma once
+
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include "TemplateFormat.h"
+
+// A set of named templates that are all compiled when the catalog is loaded, so looking a
+// message up and formatting it never parses template text.
+class TemplateCatalog
+{
+public:
+    // 'rule' is the plural rule of the catalog's language and applies to all of its templates.
+    explicit TemplateCatalog(PluralRule rule = EnglishPluralRule) : mPluralRule(rule) {}
+
+    // Compiles 'source' and stores it under 'key', replacing any existing entry.
+    bool Add(eastl::string_view key, eastl::string_view source);
+
+    // Loads "KEY=template" lines. Blank lines and lines starting with '#' are skipped, and the
+    // escapes \n, \t and \\ are expanded in templates. Returns false on the first malformed line
+    // or template, leaving the entries loaded before it in place.
+    bool Load(eastl::string_view text);
+
+    const CompiledTemplate* Find(eastl::string_view key) const;
+
+    size_t GetSize() const { return mTemplates.size(); }
+
+private:
+    eastl::hash_map<eastl::string, CompiledTemplate> mTemplates;
+    PluralRule mPluralRule;
+};
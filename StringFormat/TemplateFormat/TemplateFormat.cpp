@@ -0,0 +1,780 @@
+#include "TemplateFormat.h"
+#include "NumberFormat.h"
+
+#include <cstring>
+#include <mutex>
+#include <EASTL/algorithm.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/utility.h>
+
+namespace
+{
+    struct TemplateOutput
+    {
+        char* cursor;
+        char* limit;
+        size_t length;
+
+        void Append(const char* data, size_t count)
+        {
+            size_t available = static_cast<size_t>(limit - cursor);
+            size_t written = count < available ? count : available;
+            if (written > 0)
+            {
+                memcpy(cursor, data, written);
+                cursor += written;
+            }
+            length += count;
+        }
+
+        // Numbers are written in place when the worst case fits and staged on the stack only
+        // when the output is about to be truncated.
+        template <size_t MaxLength, typename Formatter>
+        void AppendNumber(Formatter formatter)
+        {
+            if (static_cast<size_t>(limit - cursor) >= MaxLength)
+            {
+                char* end = formatter(cursor);
+                length += static_cast<size_t>(end - cursor);
+                cursor = end;
+            }
+            else
+            {
+                char scratch[MaxLength];
+                char* end = formatter(scratch);
+                Append(scratch, static_cast<size_t>(end - scratch));
+            }
+        }
+    };
+
+    // Parses the "N$" prefix of a positional hole. Positions are 1-based in the template and
+    // stored 0-based.
+    bool ParsePosition(eastl::string_view source, size_t& position, uint16_t& argIndex, bool& positional)
+    {
+        size_t cursor = position;
+        uint32_t value = 0;
+        while (cursor < source.length() && source[cursor] >= '0' && source[cursor] <= '9')
+        {
+            value = value * 10 + static_cast<uint32_t>(source[cursor] - '0');
+            if (value > MAX_TEMPLATE_ARGS)
+            {
+                return false;
+            }
+            ++cursor;
+        }
+
+        positional = cursor != position && cursor < source.length() && source[cursor] == '$';
+        if (!positional)
+        {
+            return true;
+        }
+
+        if (value == 0)
+        {
+            return false;
+        }
+
+        argIndex = static_cast<uint16_t>(value - 1);
+        position = cursor + 1;
+        return true;
+    }
+
+    bool ParsePrecision(eastl::string_view source, size_t& position, uint16_t& precision)
+    {
+        if (position >= source.length() || source[position] != '.')
+        {
+            return true;
+        }
+
+        ++position;
+        if (position < source.length() && source[position] == '*')
+        {
+            ++position;
+            return true;
+        }
+
+        uint32_t value = 0;
+        size_t digitsStart = position;
+        while (position < source.length() && source[position] >= '0' && source[position] <= '9')
+        {
+            value = value * 10 + static_cast<uint32_t>(source[position] - '0');
+            if (value >= TemplateSegment::NO_PRECISION)
+            {
+                return false;
+            }
+            ++position;
+        }
+
+        precision = static_cast<uint16_t>(value);
+        return position != digitsStart;
+    }
+
+    void SkipLengthModifiers(eastl::string_view source, size_t& position)
+    {
+        while (position < source.length())
+        {
+            char c = source[position];
+            if (c != 'h' && c != 'l' && c != 'z' && c != 'j' && c != 't')
+            {
+                return;
+            }
+            ++position;
+        }
+    }
+
+    void FormatString(TemplateOutput& output, const TemplateSegment& segment, eastl::string_view value)
+    {
+        size_t count = value.length();
+        if (segment.precision != TemplateSegment::NO_PRECISION && segment.precision < count)
+        {
+            count = segment.precision;
+        }
+        output.Append(value.data(), count);
+    }
+
+    int64_t ToSigned(const TemplateArg& arg)
+    {
+        switch (arg.GetType())
+        {
+        case TemplateArg::Type::Unsigned: return static_cast<int64_t>(arg.GetUnsigned());
+        case TemplateArg::Type::Double: return static_cast<int64_t>(arg.GetDouble());
+        default: return arg.GetSigned();
+        }
+    }
+
+    uint64_t ToUnsigned(const TemplateArg& arg)
+    {
+        switch (arg.GetType())
+        {
+        case TemplateArg::Type::Signed: return static_cast<uint64_t>(arg.GetSigned());
+        case TemplateArg::Type::Double: return static_cast<uint64_t>(arg.GetDouble());
+        default: return arg.GetUnsigned();
+        }
+    }
+
+    double ToDouble(const TemplateArg& arg)
+    {
+        switch (arg.GetType())
+        {
+        case TemplateArg::Type::Signed: return static_cast<double>(arg.GetSigned());
+        case TemplateArg::Type::Unsigned: return static_cast<double>(arg.GetUnsigned());
+        default: return arg.GetDouble();
+        }
+    }
+
+    void FormatArg(TemplateOutput& output, const TemplateSegment& segment, const TemplateArg& arg)
+    {
+        // String arguments are passed through unchanged regardless of the hole's conversion.
+        if (arg.GetType() == TemplateArg::Type::String)
+        {
+            FormatString(output, segment, arg.GetString());
+            return;
+        }
+
+        switch (segment.type)
+        {
+        case TemplateSegmentType::Signed:
+            output.AppendNumber<MAX_INTEGER_LENGTH>([&](char* out) { return FormatSigned(ToSigned(arg), out); });
+            break;
+        case TemplateSegmentType::Unsigned:
+            output.AppendNumber<MAX_INTEGER_LENGTH>([&](char* out) { return FormatUnsigned(ToUnsigned(arg), out); });
+            break;
+        case TemplateSegmentType::Double:
+            output.AppendNumber<MAX_DOUBLE_LENGTH>([&](char* out) { return FormatDouble(ToDouble(arg), out); });
+            break;
+        case TemplateSegmentType::Fixed:
+            output.AppendNumber<MAX_FIXED_LENGTH>([&](char* out) { return FormatFixed(ToDouble(arg), segment.precision, out); });
+            break;
+        default:
+            // Numbers in string holes keep their natural representation.
+            if (arg.GetType() == TemplateArg::Type::Double)
+            {
+                output.AppendNumber<MAX_DOUBLE_LENGTH>([&](char* out) { return FormatDouble(arg.GetDouble(), out); });
+            }
+            else if (arg.GetType() == TemplateArg::Type::Signed)
+            {
+                output.AppendNumber<MAX_INTEGER_LENGTH>([&](char* out) { return FormatSigned(arg.GetSigned(), out); });
+            }
+            else
+            {
+                output.AppendNumber<MAX_INTEGER_LENGTH>([&](char* out) { return FormatUnsigned(arg.GetUnsigned(), out); });
+            }
+            break;
+        }
+    }
+}
+
+TemplateSelectKey InternSelectKey(eastl::string_view name)
+{
+    static std::mutex mutex;
+    static eastl::hash_map<eastl::string, uint32_t> keys;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = keys.find_as(name, eastl::hash<eastl::string_view>(), eastl::equal_to_2<eastl::string, eastl::string_view>());
+    if (it == keys.end())
+    {
+        it = keys.insert(eastl::make_pair(eastl::string(name.data(), name.length()), static_cast<uint32_t>(keys.size() + 1))).first;
+    }
+    return { it->second };
+}
+
+PluralCategory EnglishPluralRule(uint64_t value)
+{
+    return value == 1 ? PluralCategory::One : PluralCategory::Other;
+}
+
+PluralCategory FrenchPluralRule(uint64_t value)
+{
+    return value <= 1 ? PluralCategory::One : PluralCategory::Other;
+}
+
+PluralCategory RussianPluralRule(uint64_t value)
+{
+    uint64_t units = value % 10;
+    uint64_t tens = value % 100;
+    if (units == 1 && tens != 11)
+    {
+        return PluralCategory::One;
+    }
+    if (units >= 2 && units <= 4 && (tens < 12 || tens > 14))
+    {
+        return PluralCategory::Few;
+    }
+    return PluralCategory::Many;
+}
+
+PluralCategory NoPluralRule(uint64_t /*value*/)
+{
+    return PluralCategory::Other;
+}
+
+class TemplateCompiler
+{
+public:
+    TemplateCompiler(eastl::string_view source, CompiledTemplate& compiled) : mSource(source), mCompiled(compiled) {}
+
+    bool Compile(PluralRule rule)
+    {
+        mCompiled.mSegments.clear();
+        mCompiled.mSelectors.clear();
+        mCompiled.mBranches.clear();
+        mCompiled.mText.clear();
+        mCompiled.mPluralRule = rule;
+
+        if (!ParseSequence(false, false) || mPosition != mSource.length())
+        {
+            return false;
+        }
+
+        mCompiled.mArgCount = mArgCount;
+        return true;
+    }
+
+private:
+    bool AtEnd() const { return mPosition >= mSource.length(); }
+    char Peek() const { return mSource[mPosition]; }
+
+    void SkipSpaces()
+    {
+        while (!AtEnd() && (Peek() == ' ' || Peek() == '\t'))
+        {
+            ++mPosition;
+        }
+    }
+
+    bool Expect(char c)
+    {
+        SkipSpaces();
+        if (AtEnd() || Peek() != c)
+        {
+            return false;
+        }
+        ++mPosition;
+        return true;
+    }
+
+    eastl::string_view ParseWord()
+    {
+        SkipSpaces();
+        size_t start = mPosition;
+        while (!AtEnd() && (Peek() == '_' || Peek() == '=' || Peek() == '-' ||
+            (Peek() >= '0' && Peek() <= '9') || (Peek() >= 'a' && Peek() <= 'z') || (Peek() >= 'A' && Peek() <= 'Z')))
+        {
+            ++mPosition;
+        }
+        return mSource.substr(start, mPosition - start);
+    }
+
+    void AppendLiteral(const char* data, size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        eastl::vector<TemplateSegment>& segments = mCompiled.mSegments;
+        if (segments.size() <= mMergeFloor || segments.back().type != TemplateSegmentType::Literal)
+        {
+            segments.push_back({ TemplateSegmentType::Literal, 0, TemplateSegment::NO_PRECISION,
+                static_cast<uint32_t>(mCompiled.mText.length()), 0 });
+        }
+
+        segments.back().length += static_cast<uint32_t>(count);
+        mCompiled.mText.append(data, data + count);
+    }
+
+    bool UseArg(uint16_t argIndex, bool positional)
+    {
+        // As with POSIX printf, a template either numbers every hole or none of them.
+        if (positional ? mSequentialCount > 0 : mAnyPositional)
+        {
+            return false;
+        }
+        mAnyPositional |= positional;
+        mArgCount = eastl::max(mArgCount, static_cast<uint16_t>(argIndex + 1));
+        return true;
+    }
+
+    // Parses literal text and holes up to the end of the template or, inside a branch, up to the
+    // branch's closing brace.
+    bool ParseSequence(bool inBranch, bool inPlural)
+    {
+        size_t literalStart = mPosition;
+        while (!AtEnd())
+        {
+            char c = Peek();
+            if (c == '}' && inBranch)
+            {
+                break;
+            }
+            if (c == '{' && inBranch)
+            {
+                return false;
+            }
+            if (c != '%' && !(c == '#' && inPlural))
+            {
+                ++mPosition;
+                continue;
+            }
+
+            AppendLiteral(mSource.data() + literalStart, mPosition - literalStart);
+            ++mPosition;
+
+            if (c == '#')
+            {
+                mCompiled.mSegments.push_back({ TemplateSegmentType::PluralValue, 0, TemplateSegment::NO_PRECISION, 0, 0 });
+            }
+            else if (!AtEnd() && Peek() == '%')
+            {
+                AppendLiteral("%", 1);
+                ++mPosition;
+            }
+            else if (!AtEnd() && Peek() == '{')
+            {
+                ++mPosition;
+                if (!ParseSelector(inPlural))
+                {
+                    return false;
+                }
+            }
+            else if (!ParseHole())
+            {
+                return false;
+            }
+
+            literalStart = mPosition;
+        }
+
+        AppendLiteral(mSource.data() + literalStart, mPosition - literalStart);
+        return true;
+    }
+
+    bool ParseHole()
+    {
+        TemplateSegment segment = { TemplateSegmentType::String, mSequentialCount, TemplateSegment::NO_PRECISION, 0, 0 };
+        bool positional = false;
+        if (!ParsePosition(mSource, mPosition, segment.argIndex, positional) ||
+            !UseArg(segment.argIndex, positional) ||
+            !ParsePrecision(mSource, mPosition, segment.precision))
+        {
+            return false;
+        }
+        SkipLengthModifiers(mSource, mPosition);
+
+        if (AtEnd())
+        {
+            return false;
+        }
+
+        switch (Peek())
+        {
+        case 's':
+            segment.type = TemplateSegmentType::String;
+            break;
+        case 'd':
+        case 'i':
+            segment.type = TemplateSegmentType::Signed;
+            break;
+        case 'u':
+            segment.type = TemplateSegmentType::Unsigned;
+            break;
+        case 'f':
+        case 'F':
+            segment.type = TemplateSegmentType::Fixed;
+            if (segment.precision == TemplateSegment::NO_PRECISION)
+            {
+                segment.precision = 6;
+            }
+            if (segment.precision > MAX_FIXED_PRECISION)
+            {
+                return false;
+            }
+            break;
+        case 'g':
+        case 'G':
+            segment.type = TemplateSegmentType::Double;
+            break;
+        default:
+            return false;
+        }
+        ++mPosition;
+
+        if (segment.type != TemplateSegmentType::String && segment.type != TemplateSegmentType::Fixed &&
+            segment.precision != TemplateSegment::NO_PRECISION)
+        {
+            return false;
+        }
+
+        if (!positional)
+        {
+            if (mSequentialCount == MAX_TEMPLATE_ARGS)
+            {
+                return false;
+            }
+            ++mSequentialCount;
+        }
+
+        mCompiled.mSegments.push_back(segment);
+        return true;
+    }
+
+    static bool ParseCategory(eastl::string_view word, PluralCategory& category)
+    {
+        static const char* const NAMES[] = { "zero", "one", "two", "few", "many", "other" };
+        for (size_t i = 0; i < static_cast<size_t>(PluralCategory::Count); ++i)
+        {
+            if (word == NAMES[i])
+            {
+                category = static_cast<PluralCategory>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool ParseExactValue(eastl::string_view word, int64_t& value)
+    {
+        bool negative = word.length() > 1 && word[0] == '-';
+        word.remove_prefix(negative ? 1 : 0);
+        if (word.empty() || word.length() > 18)
+        {
+            return false;
+        }
+
+        value = 0;
+        for (char c : word)
+        {
+            if (c < '0' || c > '9')
+            {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        value = negative ? -value : value;
+        return true;
+    }
+
+    // Parses "N, plural|select, key {branch} ... other {branch}}" after the opening "%{". Branch
+    // segments are laid out straight after the selector segment, which records how many there
+    // are so that formatting can skip the branches it does not take.
+    bool ParseSelector(bool inPlural)
+    {
+        SkipSpaces();
+        uint32_t position = 0;
+        size_t digitsStart = mPosition;
+        while (!AtEnd() && Peek() >= '0' && Peek() <= '9' && position <= MAX_TEMPLATE_ARGS)
+        {
+            position = position * 10 + static_cast<uint32_t>(Peek() - '0');
+            ++mPosition;
+        }
+
+        if (mPosition == digitsStart || position == 0 || position > MAX_TEMPLATE_ARGS)
+        {
+            return false;
+        }
+
+        uint16_t argIndex = static_cast<uint16_t>(position - 1);
+        if (!UseArg(argIndex, true) || !Expect(','))
+        {
+            return false;
+        }
+
+        eastl::string_view kind = ParseWord();
+        TemplateSelector selector = {};
+        if (kind == "plural")
+        {
+            selector.type = TemplateSelectorType::Plural;
+        }
+        else if (kind == "select")
+        {
+            selector.type = TemplateSelectorType::Select;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (!Expect(','))
+        {
+            return false;
+        }
+
+        selector.otherBranch = TemplateSelector::NO_BRANCH;
+        for (uint16_t& branch : selector.categoryBranches)
+        {
+            branch = TemplateSelector::NO_BRANCH;
+        }
+
+        size_t selectorIndex = mCompiled.mSelectors.size();
+        size_t selectorSegment = mCompiled.mSegments.size();
+        mCompiled.mSelectors.push_back(selector);
+        mCompiled.mSegments.push_back({ TemplateSegmentType::Selector, argIndex, TemplateSegment::NO_PRECISION,
+            static_cast<uint32_t>(selectorIndex), 0 });
+
+        // Branches of nested selectors are appended while parsing, so each selector's own
+        // branches are collected here and appended as one contiguous run afterwards.
+        eastl::vector<TemplateBranch> branches;
+        bool isPlural = selector.type == TemplateSelectorType::Plural;
+        for (;;)
+        {
+            SkipSpaces();
+            if (AtEnd())
+            {
+                return false;
+            }
+            if (Peek() == '}')
+            {
+                ++mPosition;
+                break;
+            }
+
+            eastl::string_view word = ParseWord();
+            TemplateBranch branch = { TemplateBranch::Match::Key, 0, 0, 0 };
+            PluralCategory category = PluralCategory::Other;
+            if (word == "other")
+            {
+                branch.match = TemplateBranch::Match::Other;
+            }
+            else if (isPlural && !word.empty() && word[0] == '=')
+            {
+                branch.match = TemplateBranch::Match::Exact;
+                if (!ParseExactValue(word.substr(1), branch.value))
+                {
+                    return false;
+                }
+            }
+            else if (isPlural)
+            {
+                branch.match = TemplateBranch::Match::Category;
+                if (!ParseCategory(word, category))
+                {
+                    return false;
+                }
+                branch.value = static_cast<int64_t>(category);
+            }
+            else if (!word.empty())
+            {
+                branch.value = InternSelectKey(word).id;
+            }
+            else
+            {
+                return false;
+            }
+
+            if (!Expect('{'))
+            {
+                return false;
+            }
+
+            size_t mergeFloor = mMergeFloor;
+            mMergeFloor = mCompiled.mSegments.size();
+            branch.segmentBegin = static_cast<uint32_t>(mCompiled.mSegments.size());
+            if (!ParseSequence(true, inPlural || isPlural) || !Expect('}'))
+            {
+                return false;
+            }
+            branch.segmentEnd = static_cast<uint32_t>(mCompiled.mSegments.size());
+            mMergeFloor = mergeFloor;
+
+            branches.push_back(branch);
+        }
+
+        TemplateSelector& compiledSelector = mCompiled.mSelectors[selectorIndex];
+        compiledSelector.branchBegin = static_cast<uint16_t>(mCompiled.mBranches.size());
+        compiledSelector.branchCount = static_cast<uint16_t>(branches.size());
+        for (size_t i = 0; i < branches.size(); ++i)
+        {
+            uint16_t branchIndex = static_cast<uint16_t>(compiledSelector.branchBegin + i);
+            if (branches[i].match == TemplateBranch::Match::Other)
+            {
+                compiledSelector.otherBranch = branchIndex;
+            }
+            else if (branches[i].match == TemplateBranch::Match::Category)
+            {
+                compiledSelector.categoryBranches[branches[i].value] = branchIndex;
+            }
+            mCompiled.mBranches.push_back(branches[i]);
+        }
+
+        if (compiledSelector.otherBranch == TemplateSelector::NO_BRANCH ||
+            mCompiled.mBranches.size() >= TemplateSelector::NO_BRANCH)
+        {
+            return false;
+        }
+
+        TemplateSegment& segment = mCompiled.mSegments[selectorSegment];
+        segment.length = static_cast<uint32_t>(mCompiled.mSegments.size() - selectorSegment - 1);
+        mMergeFloor = mCompiled.mSegments.size();
+        return true;
+    }
+
+    eastl::string_view mSource;
+    CompiledTemplate& mCompiled;
+    size_t mPosition = 0;
+    size_t mMergeFloor = 0;
+    uint16_t mArgCount = 0;
+    uint16_t mSequentialCount = 0;
+    bool mAnyPositional = false;
+};
+
+bool CompileTemplate(eastl::string_view source, CompiledTemplate& compiled, PluralRule rule)
+{
+    return TemplateCompiler(source, compiled).Compile(rule);
+}
+
+namespace
+{
+    struct TemplateFormatter
+    {
+        const CompiledTemplate& compiled;
+        const TemplateArg* args;
+        size_t argCount;
+        TemplateOutput output;
+
+        const TemplateBranch* SelectBranch(const TemplateSelector& selector, const TemplateArg& arg) const
+        {
+            const TemplateBranch* branches = compiled.GetBranches().data() + selector.branchBegin;
+            const TemplateBranch* other = compiled.GetBranches().data() + selector.otherBranch;
+
+            if (selector.type == TemplateSelectorType::Select)
+            {
+                if (arg.GetType() != TemplateArg::Type::Key)
+                {
+                    return other;
+                }
+
+                for (uint16_t i = 0; i < selector.branchCount; ++i)
+                {
+                    if (branches[i].match == TemplateBranch::Match::Key && branches[i].value == arg.GetKey())
+                    {
+                        return &branches[i];
+                    }
+                }
+                return other;
+            }
+
+            // Plural categories only apply to whole numbers; "1.5" takes the other branch.
+            int64_t value = 0;
+            switch (arg.GetType())
+            {
+            case TemplateArg::Type::Signed: value = arg.GetSigned(); break;
+            case TemplateArg::Type::Unsigned: value = static_cast<int64_t>(arg.GetUnsigned()); break;
+            case TemplateArg::Type::Double:
+                value = static_cast<int64_t>(arg.GetDouble());
+                if (static_cast<double>(value) != arg.GetDouble())
+                {
+                    return other;
+                }
+                break;
+            default: return other;
+            }
+
+            for (uint16_t i = 0; i < selector.branchCount; ++i)
+            {
+                if (branches[i].match == TemplateBranch::Match::Exact && branches[i].value == value)
+                {
+                    return &branches[i];
+                }
+            }
+
+            uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+            uint16_t branch = selector.categoryBranches[static_cast<size_t>(compiled.GetPluralRule()(magnitude))];
+            return branch != TemplateSelector::NO_BRANCH ? compiled.GetBranches().data() + branch : other;
+        }
+
+        void FormatRange(uint32_t begin, uint32_t end, const TemplateArg* pluralArg)
+        {
+            const TemplateSegment* segments = compiled.GetSegments().data();
+            const char* text = compiled.GetText().data();
+
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const TemplateSegment& segment = segments[i];
+                switch (segment.type)
+                {
+                case TemplateSegmentType::Literal:
+                    output.Append(text + segment.offset, segment.length);
+                    break;
+                case TemplateSegmentType::PluralValue:
+                    if (pluralArg != nullptr)
+                    {
+                        FormatArg(output, segment, *pluralArg);
+                    }
+                    break;
+                case TemplateSegmentType::Selector:
+                    if (segment.argIndex < argCount)
+                    {
+                        const TemplateSelector& selector = compiled.GetSelectors()[segment.offset];
+                        const TemplateArg& arg = args[segment.argIndex];
+                        const TemplateBranch* branch = SelectBranch(selector, arg);
+                        FormatRange(branch->segmentBegin, branch->segmentEnd,
+                            selector.type == TemplateSelectorType::Plural ? &arg : pluralArg);
+                    }
+                    i += segment.length;
+                    break;
+                default:
+                    if (segment.argIndex < argCount)
+                    {
+                        FormatArg(output, segment, args[segment.argIndex]);
+                    }
+                    break;
+                }
+            }
+        }
+    };
+}
+
+size_t FormatTemplate(const CompiledTemplate& compiled, const TemplateArg* args, size_t argCount,
+    char* buffer, size_t capacity)
+{
+    TemplateFormatter formatter = { compiled, args, argCount,
+        { buffer, capacity > 0 ? buffer + capacity - 1 : buffer, 0 } };
+    formatter.FormatRange(0, static_cast<uint32_t>(compiled.GetSegments().size()), nullptr);
+
+    if (capacity > 0)
+    {
+        *formatter.output.cursor = '\0';
+    }
+
+    return formatter.output.length;
+}
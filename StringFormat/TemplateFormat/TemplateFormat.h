@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <EASTL/string.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/vector.h>
+
+// An interned keyword for "select" selectors, eg: "female". Keywords are interned when templates
+// are compiled, so selecting a branch compares ids instead of strings.
+struct TemplateSelectKey
+{
+    uint32_t id;
+};
+
+// Returns the id for 'name', interning it on first use. Intended for setup code; callers should
+// keep the returned key rather than interning per message.
+TemplateSelectKey InternSelectKey(eastl::string_view name);
+
+// A single argument for a template hole. Strings are carried as a pointer and length so that
+// "%.*s" takes one argument instead of printf's two.
+class TemplateArg
+{
+public:
+    enum class Type : uint8_t
+    {
+        String,
+        Signed,
+        Unsigned,
+        Double,
+        Key
+    };
+
+    TemplateArg(eastl::string_view value) : mType(Type::String)
+    {
+        mValue.string.data = value.data();
+        mValue.string.length = value.length();
+    }
+
+    TemplateArg(const char* value) : TemplateArg(eastl::string_view(value)) {}
+    TemplateArg(const eastl::string& value) : TemplateArg(eastl::string_view(value.data(), value.length())) {}
+
+    template <typename T, typename eastl::enable_if<eastl::is_integral<T>::value && eastl::is_signed<T>::value, int>::type = 0>
+    TemplateArg(T value) : mType(Type::Signed)
+    {
+        mValue.signedValue = value;
+    }
+
+    template <typename T, typename eastl::enable_if<eastl::is_integral<T>::value && !eastl::is_signed<T>::value, int>::type = 0>
+    TemplateArg(T value) : mType(Type::Unsigned)
+    {
+        mValue.unsignedValue = value;
+    }
+
+    TemplateArg(double value) : mType(Type::Double)
+    {
+        mValue.doubleValue = value;
+    }
+
+    TemplateArg(TemplateSelectKey value) : mType(Type::Key)
+    {
+        mValue.key = value.id;
+    }
+
+    Type GetType() const { return mType; }
+    eastl::string_view GetString() const { return eastl::string_view(mValue.string.data, mValue.string.length); }
+    int64_t GetSigned() const { return mValue.signedValue; }
+    uint64_t GetUnsigned() const { return mValue.unsignedValue; }
+    double GetDouble() const { return mValue.doubleValue; }
+    uint32_t GetKey() const { return mValue.key; }
+
+private:
+    Type mType;
+    union
+    {
+        struct
+        {
+            const char* data;
+            size_t length;
+        } string;
+        int64_t signedValue;
+        uint64_t unsignedValue;
+        double doubleValue;
+        uint32_t key;
+    } mValue;
+};
+
+// CLDR plural categories. A plural rule maps the absolute value of an integer to its category
+// for one language.
+enum class PluralCategory : uint8_t
+{
+    Zero,
+    One,
+    Two,
+    Few,
+    Many,
+    Other,
+    Count
+};
+
+typedef PluralCategory (*PluralRule)(uint64_t value);
+
+PluralCategory EnglishPluralRule(uint64_t value);
+PluralCategory FrenchPluralRule(uint64_t value);
+PluralCategory RussianPluralRule(uint64_t value);
+PluralCategory NoPluralRule(uint64_t value);
+
+enum class TemplateSegmentType : uint8_t
+{
+    Literal,
+    String,
+    Signed,
+    Unsigned,
+    Double,
+    Fixed,
+    Selector,
+    PluralValue
+};
+
+constexpr uint16_t MAX_TEMPLATE_ARGS = 255;
+
+// For Literal segments 'offset' and 'length' locate the text. For Selector segments 'offset'
+// indexes the selector table and 'length' is the number of branch segments that follow it.
+struct TemplateSegment
+{
+    static constexpr uint16_t NO_PRECISION = 0xFFFF;
+
+    TemplateSegmentType type;
+    uint16_t argIndex;
+    uint16_t precision;
+    uint32_t offset;
+    uint32_t length;
+};
+
+enum class TemplateSelectorType : uint8_t
+{
+    Plural,
+    Select
+};
+
+struct TemplateBranch
+{
+    enum class Match : uint8_t
+    {
+        Exact,
+        Category,
+        Key,
+        Other
+    };
+
+    Match match;
+    int64_t value;
+    uint32_t segmentBegin;
+    uint32_t segmentEnd;
+};
+
+// Branch table for one selector. Plural categories index straight into their branch, so only
+// explicit "=N" branches are searched, and those by integer comparison.
+struct TemplateSelector
+{
+    static constexpr uint16_t NO_BRANCH = 0xFFFF;
+
+    TemplateSelectorType type;
+    uint16_t branchBegin;
+    uint16_t branchCount;
+    uint16_t otherBranch;
+    uint16_t categoryBranches[static_cast<size_t>(PluralCategory::Count)];
+};
+
+// A template parsed once into literal runs, typed holes and selector branch tables. Literal bytes
+// are owned by the compiled template so the source text does not need to outlive it.
+class CompiledTemplate
+{
+public:
+    const eastl::vector<TemplateSegment>& GetSegments() const { return mSegments; }
+    const eastl::vector<TemplateSelector>& GetSelectors() const { return mSelectors; }
+    const eastl::vector<TemplateBranch>& GetBranches() const { return mBranches; }
+    const eastl::string& GetText() const { return mText; }
+    uint16_t GetArgCount() const { return mArgCount; }
+    PluralRule GetPluralRule() const { return mPluralRule; }
+
+private:
+    friend class TemplateCompiler;
+
+    eastl::vector<TemplateSegment> mSegments;
+    eastl::vector<TemplateSelector> mSelectors;
+    eastl::vector<TemplateBranch> mBranches;
+    eastl::string mText;
+    uint16_t mArgCount = 0;
+    PluralRule mPluralRule = EnglishPluralRule;
+};
+
+// Parses a printf-style template. Supported holes are %s, %.*s, %.Ns, %d, %i, %u, %f, %.Nf, %g
+// (shortest round-trip) and %%. Length modifiers (h, l, ll, z, j, t) are accepted and ignored.
+// Holes may be numbered ("%2$.*s") so localised templates can reorder arguments; the argument
+// index is resolved here, so reordered templates format at the same cost as in-order ones.
+//
+// Selectors in the style of ICU plural/select pick a branch by argument:
+//     %{1, plural, =0 {no calls} one {# call} other {# calls}}
+//     %{2, select, female {her} male {him} other {them}}
+// Selectors always name their argument, so templates that use them must number every hole. '#'
+// in a plural branch prints the plural argument, and 'rule' decides its category.
+//
+// Returns false if the template contains anything else, mixes numbered and unnumbered holes or
+// has a selector without an "other" branch.
+bool CompileTemplate(eastl::string_view source, CompiledTemplate& compiled, PluralRule rule = EnglishPluralRule);
+
+// Formats straight into 'buffer' with snprintf semantics: the output is truncated to
+// capacity - 1 characters and null terminated, and the untruncated length is returned. Holes
+// without a matching argument are left empty. Formatting never allocates.
+size_t FormatTemplate(const CompiledTemplate& compiled, const TemplateArg* args, size_t argCount,
+    char* buffer, size_t capacity);
+
+inline size_t FormatTemplate(const CompiledTemplate& compiled, std::initializer_list<TemplateArg> args,
+    char* buffer, size_t capacity)
+{
+    return FormatTemplate(compiled, args.begin(), args.size(), buffer, capacity);
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <EASTL/string.h>
+#include "TemplateCache.h"
+#include "TemplateCatalog.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr eastl::string_view ENGLISH_CATALOG =
+    "MOE_DIALOGUE_1=Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\\n\n"
+    "MOE_DIALOGUE_2=Uh, %.*s? Hey, I'm lookin for %.*s!\\n\n"
+    "MOE_DIALOGUE_3=That's %d calls tonight, %.*s! You owe me $%.2f for the tab!\\n\n"
+    "MOE_DIALOGUE_4=Is there a %1$.*s %2$.*s here?\\n\n"
+    "MOE_DIALOGUE_5=%{1, plural, one {One more call} other {# more calls}} from %2$.*s and %{3, select, male {he's} female {she's} other {they're}} barred!\\n\n";
+
+// Family name first: the surname hole is moved ahead of the given name without touching callers.
+constexpr eastl::string_view SURNAME_FIRST_CATALOG =
+    "MOE_DIALOGUE_4=Is there a %2$.*s %1$.*s here?\\n\n";
+
+constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+constexpr eastl::string_view PRANK_NAME_2 = "Amanda Hugginkiss";
+constexpr eastl::string_view PRANK_NAME_3 = "Hugh Jass";
+
+eastl::string_view FirstName(eastl::string_view fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    return delimiterPosition != eastl::string_view::npos ? fullName.substr(0, delimiterPosition) : fullName;
+}
+
+void Print(const char* buffer, size_t length, size_t capacity)
+{
+    fwrite(buffer, 1, length < capacity ? length : capacity - 1, stdout);
+}
+
+void PrankMoe(const CompiledTemplate& localised, eastl::string_view fullName)
+{
+    char buffer[256];
+    size_t length = FormatTemplate(localised, { FirstName(fullName), fullName }, buffer, sizeof(buffer));
+    Print(buffer, length, sizeof(buffer));
+}
+
+void PrankMoe(const CompiledTemplate& localised, eastl::string_view fullName, int callCount, double tab)
+{
+    char buffer[256];
+    size_t length = FormatTemplate(localised, { callCount, FirstName(fullName), tab }, buffer, sizeof(buffer));
+    Print(buffer, length, sizeof(buffer));
+}
+
+void PrankMoeFormally(const CompiledTemplate& localised, eastl::string_view fullName)
+{
+    eastl::string_view firstName = FirstName(fullName);
+    eastl::string_view surname = firstName.length() < fullName.length() ? fullName.substr(firstName.length() + 1) : eastl::string_view();
+
+    char buffer[256];
+    size_t length = FormatTemplate(localised, { firstName, surname }, buffer, sizeof(buffer));
+    Print(buffer, length, sizeof(buffer));
+}
+
+void PrankMoeAgain(const CompiledTemplate& localised, eastl::string_view fullName, int callCount, TemplateSelectKey gender)
+{
+    char buffer[256];
+    size_t length = FormatTemplate(localised, { callCount, FirstName(fullName), gender }, buffer, sizeof(buffer));
+    Print(buffer, length, sizeof(buffer));
+}
+
+// Templates that only exist at run time, eg: from configuration, are compiled on first use and
+// reused from the process-wide cache afterwards.
+void PrankMoe(eastl::string_view configured, eastl::string_view fullName)
+{
+    char buffer[256];
+    size_t length = FormatCachedTemplate(configured, { FirstName(fullName), fullName }, buffer, sizeof(buffer));
+    Print(buffer, length, sizeof(buffer));
+}
+
+int main(int argc, char** argv)
+{
+    TemplateCatalog english;
+    TemplateCatalog surnameFirst;
+    if (!english.Load(ENGLISH_CATALOG) || !surnameFirst.Load(SURNAME_FIRST_CATALOG))
+    {
+        printf("Failed to load dialogue catalogs\n");
+        return 1;
+    }
+
+    PrankMoe(*english.Find("MOE_DIALOGUE_1"), PRANK_NAME_1);
+    PrankMoe(*english.Find("MOE_DIALOGUE_2"), PRANK_NAME_2);
+    PrankMoe(*english.Find("MOE_DIALOGUE_3"), PRANK_NAME_3, 3, 12.5);
+    PrankMoeFormally(*english.Find("MOE_DIALOGUE_4"), PRANK_NAME_3);
+    PrankMoeFormally(*surnameFirst.Find("MOE_DIALOGUE_4"), PRANK_NAME_3);
+
+    TemplateSelectKey female = InternSelectKey("female");
+    TemplateSelectKey male = InternSelectKey("male");
+    PrankMoeAgain(*english.Find("MOE_DIALOGUE_5"), PRANK_NAME_2, 1, female);
+    PrankMoeAgain(*english.Find("MOE_DIALOGUE_5"), PRANK_NAME_1, 4, male);
+
+    if (argc > 1)
+    {
+        eastl::string configured = argv[1];
+        configured += '\n';
+        PrankMoe(eastl::string_view(configured.data(), configured.length()), PRANK_NAME_1);
+        PrankMoe(eastl::string_view(configured.data(), configured.length()), PRANK_NAME_2);
+        PrankMoe(eastl::string_view(configured.data(), configured.length()), PRANK_NAME_3);
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <cstdio>
+#include <string_view>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_format)
+#include <format>
+#include <string>
+
+// std::format takes its own placeholders rather than printf conversions. The dialogue is
+// localised, so the format string is only known at runtime and goes through std::vformat().
+constexpr std::string_view MOE_DIALOGUE_1 = "Hey, is there a {} here? Hey, everybody, I wanna {}!\n";
+constexpr std::string_view MOE_DIALOGUE_2 = "Uh, {}? Hey, I'm lookin for {}!\n";
+#else
+// Standard libraries without std::format (GCC before 13, for example) fall back to snprintf.
+constexpr std::string_view MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+constexpr std::string_view MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+#endif
+
+constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+constexpr std::string_view PRANK_NAME_2 = "Amanda Hugginkiss";
+
+void PrankMoe(std::string_view localised, std::string_view fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    std::string_view outputName = delimiterPosition != std::string_view::npos ?
+        fullName.substr(0, delimiterPosition) : fullName;
+
+#if defined(__cpp_lib_format)
+    std::string output = std::vformat(localised, std::make_format_args(outputName, fullName));
+    fwrite(output.data(), 1, output.length(), stdout);
+#else
+    char output[256];
+    int length = snprintf(output, sizeof(output), localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    if (length > 0)
+    {
+        fwrite(output, 1, static_cast<size_t>(length) < sizeof(output) ? static_cast<size_t>(length) : sizeof(output) - 1, stdout);
+    }
+#endif
+}
+
+int main()
+{
+    PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1);
+    PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2);
+
+    return 0;
+}
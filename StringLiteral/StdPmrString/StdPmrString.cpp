@@ -0,0 +1,34 @@
+#include <iostream>
+#include <memory_resource>
+#include <string>
+
+// Every string below, including the temporaries created for each call, is carved out of this
+// buffer; the global heap is only touched if it runs out.
+char gStringBuffer[1024];
+std::pmr::monotonic_buffer_resource gStringResource(gStringBuffer, sizeof(gStringBuffer));
+
+const std::pmr::string MOE_DIALOGUE_1("Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n", &gStringResource);
+const std::pmr::string MOE_DIALOGUE_2("Uh, %.*s? Hey, I'm lookin for %.*s!\n", &gStringResource);
+
+const char* PRANK_NAME_1 = "Seymour Butz";
+const std::pmr::string PRANK_NAME_2("Amanda Hugginkiss", &gStringResource);
+
+void PrankMoe(const std::pmr::string& localised, const std::pmr::string& fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    size_t firstNameLength = delimiterPosition != std::pmr::string::npos ? delimiterPosition : fullName.length();
+
+    // substr() and copies take their allocator from the default resource, so the copy is
+    // constructed with the caller's allocator explicitly.
+    std::pmr::string outputName(fullName, 0, firstNameLength, fullName.get_allocator());
+
+    printf(localised.data(), outputName.length(), outputName.data(), fullName.length(), fullName.data());
+}
+
+int main()
+{
+    PrankMoe(MOE_DIALOGUE_1, std::pmr::string(PRANK_NAME_1, &gStringResource));
+    PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2);
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#include <iostream>
+#include <string>
+
+const std::string MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+const std::string MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+const char* PRANK_NAME_1 = "Seymour Butz";
+const std::string PRANK_NAME_2 = "Amanda Hugginkiss";
+
+void PrankMoe(const std::string& localised, const std::string& fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    std::string outputName = delimiterPosition != std::string::npos ?
+        fullName.substr(0, delimiterPosition) : fullName;
+
+    printf(localised.data(), outputName.length(), outputName.data(), fullName.length(), fullName.data());
+}
+
+int main()
+{
+    PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1);
+    PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "CodeSize.h"
+
+#include <cstdio>
+#include <cstring>
+#include <EASTL/vector.h>
+
+#if defined(__linux__)
+#include <elf.h>
+#endif
+
+namespace
+{
+    bool ReadFile(const char* path, eastl::vector<char>& contents)
+    {
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        bool read = false;
+        if (length > 0)
+        {
+            contents.resize(static_cast<size_t>(length));
+            read = fread(contents.data(), 1, contents.size(), file) == contents.size();
+        }
+        fclose(file);
+        return read;
+    }
+}
+
+bool ReadCodeSize(const char* path, CodeSize& size)
+{
+#if defined(__linux__)
+    eastl::vector<char> contents;
+    if (!ReadFile(path, contents) || contents.size() < sizeof(Elf64_Ehdr))
+    {
+        return false;
+    }
+
+    const Elf64_Ehdr* header = reinterpret_cast<const Elf64_Ehdr*>(contents.data());
+    if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 || header->e_ident[EI_CLASS] != ELFCLASS64 ||
+        header->e_shoff + static_cast<size_t>(header->e_shnum) * sizeof(Elf64_Shdr) > contents.size())
+    {
+        return false;
+    }
+
+    const Elf64_Shdr* sections = reinterpret_cast<const Elf64_Shdr*>(contents.data() + header->e_shoff);
+    size = {};
+    for (size_t i = 0; i < header->e_shnum; ++i)
+    {
+        const Elf64_Shdr& section = sections[i];
+        if ((section.sh_flags & SHF_EXECINSTR) != 0)
+        {
+            size.textBytes += section.sh_size;
+        }
+
+        if (section.sh_type != SHT_SYMTAB || section.sh_link >= header->e_shnum ||
+            section.sh_offset + section.sh_size > contents.size())
+        {
+            continue;
+        }
+
+        const Elf64_Shdr& names = sections[section.sh_link];
+        const Elf64_Sym* symbols = reinterpret_cast<const Elf64_Sym*>(contents.data() + section.sh_offset);
+        size_t symbolCount = section.sh_size / sizeof(Elf64_Sym);
+        for (size_t s = 0; s < symbolCount; ++s)
+        {
+            if (ELF64_ST_TYPE(symbols[s].st_info) != STT_FUNC || symbols[s].st_name >= names.sh_size)
+            {
+                continue;
+            }
+
+            const char* name = contents.data() + names.sh_offset + symbols[s].st_name;
+            if (strstr(name, "PrankMoe") != nullptr)
+            {
+                size.prankMoeBytes += symbols[s].st_size;
+            }
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+struct CodeSize
+{
+    // Bytes in executable sections.
+    size_t textBytes;
+    // Bytes in functions whose symbol contains 'PrankMoe', including compiler split clones.
+    size_t prankMoeBytes;
+};
+
+// Reads the sizes from an ELF binary's section headers and symbol table. Returns false if the
+// file cannot be read, is not a 64-bit ELF file or the platform has no ELF support.
+bool ReadCodeSize(const char* path, CodeSize& size);
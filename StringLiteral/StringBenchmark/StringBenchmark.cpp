@@ -0,0 +1,321 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include "CodeSize.h"
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+// Every heap allocation in the process is counted, whichever library makes it.
+std::atomic<uint64_t> gAllocations{ 0 };
+
+void* operator new(size_t size)
+{
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+// Each variant below follows PrankMoe() from the example of the same name and each Run function
+// makes the same two calls as that example's main(). All of them write to a buffer instead of
+// stdout. StdPmrStringVariant also changes how its strings are allocated: its globals use the
+// default resource rather than a shared global buffer, and PrankMoe() takes the resource for its
+// temporaries as an extra parameter, which Run() points at a fresh stack buffer for each pair of
+// calls.
+constexpr size_t OUTPUT_CAPACITY = 256;
+
+namespace CStringVariant
+{
+    constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+    const char* MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+    constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+    constexpr const char* PRANK_NAME_2 = "Amanda Hugginkiss";
+
+    int PrankMoe(const char* localised, const char* fullName, char* output)
+    {
+        const char* delimiter = std::strchr(fullName, ' ');
+        int firstNameLength = delimiter != nullptr ? static_cast<int>(delimiter - fullName) : static_cast<int>(strlen(fullName));
+
+        return snprintf(output, OUTPUT_CAPACITY, localised, firstNameLength, fullName, static_cast<int>(strlen(fullName)), fullName);
+    }
+
+    int Run(char* output)
+    {
+        return PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1, output) + PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2, output);
+    }
+}
+
+namespace EASTLStringVariant
+{
+    const eastl::string MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+    const eastl::string MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+    const char* PRANK_NAME_1 = "Seymour Butz";
+    const eastl::string PRANK_NAME_2 = "Amanda Hugginkiss";
+
+    int PrankMoe(const eastl::string& localised, const eastl::string& fullName, char* output)
+    {
+        size_t delimiterPosition = fullName.find(' ');
+        eastl::string outputName = delimiterPosition != eastl::string::npos ?
+            fullName.substr(0, delimiterPosition) : fullName;
+
+        return snprintf(output, OUTPUT_CAPACITY, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+            static_cast<int>(fullName.length()), fullName.data());
+    }
+
+    int Run(char* output)
+    {
+        return PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1, output) + PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2, output);
+    }
+}
+
+namespace StringViewVariant
+{
+    constexpr eastl::string_view MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+    constexpr eastl::string_view MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+    constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+    constexpr eastl::string_view PRANK_NAME_2 = "Amanda Hugginkiss";
+
+    int PrankMoe(eastl::string_view localised, eastl::string_view fullName, char* output)
+    {
+        size_t delimiterPosition = fullName.find(' ');
+        eastl::string_view outputName = delimiterPosition != eastl::string_view::npos ?
+            fullName.substr(0, delimiterPosition) : fullName;
+
+        return snprintf(output, OUTPUT_CAPACITY, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+            static_cast<int>(fullName.length()), fullName.data());
+    }
+
+    int Run(char* output)
+    {
+        return PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1, output) + PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2, output);
+    }
+}
+
+namespace StdStringVariant
+{
+    const std::string MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+    const std::string MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+    const char* PRANK_NAME_1 = "Seymour Butz";
+    const std::string PRANK_NAME_2 = "Amanda Hugginkiss";
+
+    int PrankMoe(const std::string& localised, const std::string& fullName, char* output)
+    {
+        size_t delimiterPosition = fullName.find(' ');
+        std::string outputName = delimiterPosition != std::string::npos ?
+            fullName.substr(0, delimiterPosition) : fullName;
+
+        return snprintf(output, OUTPUT_CAPACITY, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+            static_cast<int>(fullName.length()), fullName.data());
+    }
+
+    int Run(char* output)
+    {
+        return PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1, output) + PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2, output);
+    }
+}
+
+namespace StdStringViewVariant
+{
+    constexpr std::string_view MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+    constexpr std::string_view MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+    constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+    constexpr std::string_view PRANK_NAME_2 = "Amanda Hugginkiss";
+
+    int PrankMoe(std::string_view localised, std::string_view fullName, char* output)
+    {
+        size_t delimiterPosition = fullName.find(' ');
+        std::string_view outputName = delimiterPosition != std::string_view::npos ?
+            fullName.substr(0, delimiterPosition) : fullName;
+
+        return snprintf(output, OUTPUT_CAPACITY, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+            static_cast<int>(fullName.length()), fullName.data());
+    }
+
+    int Run(char* output)
+    {
+        return PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1, output) + PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2, output);
+    }
+}
+
+namespace StdPmrStringVariant
+{
+    const std::pmr::string MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+    const std::pmr::string MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+    const char* PRANK_NAME_1 = "Seymour Butz";
+    const std::pmr::string PRANK_NAME_2 = "Amanda Hugginkiss";
+
+    int PrankMoe(const std::pmr::string& localised, const std::pmr::string& fullName, std::pmr::memory_resource* resource, char* output)
+    {
+        size_t delimiterPosition = fullName.find(' ');
+        size_t firstNameLength = delimiterPosition != std::pmr::string::npos ? delimiterPosition : fullName.length();
+        std::pmr::string outputName(fullName, 0, firstNameLength, resource);
+
+        return snprintf(output, OUTPUT_CAPACITY, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+            static_cast<int>(fullName.length()), fullName.data());
+    }
+
+    // The temporaries for each pair of calls come from a stack buffer, as a per-request arena would.
+    int Run(char* output)
+    {
+        char buffer[512];
+        std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+        return PrankMoe(MOE_DIALOGUE_1, std::pmr::string(PRANK_NAME_1, &resource), &resource, output) +
+            PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2, &resource, output);
+    }
+}
+
+namespace StdFormatVariant
+{
+#if defined(__cpp_lib_format)
+    constexpr std::string_view MOE_DIALOGUE_1 = "Hey, is there a {} here? Hey, everybody, I wanna {}!\n";
+    constexpr std::string_view MOE_DIALOGUE_2 = "Uh, {}? Hey, I'm lookin for {}!\n";
+#else
+    constexpr std::string_view MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+    constexpr std::string_view MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+#endif
+
+    constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+    constexpr std::string_view PRANK_NAME_2 = "Amanda Hugginkiss";
+
+    int PrankMoe(std::string_view localised, std::string_view fullName, char* output)
+    {
+        size_t delimiterPosition = fullName.find(' ');
+        std::string_view outputName = delimiterPosition != std::string_view::npos ?
+            fullName.substr(0, delimiterPosition) : fullName;
+
+#if defined(__cpp_lib_format)
+        std::string formatted = std::vformat(localised, std::make_format_args(outputName, fullName));
+        size_t length = formatted.length() < OUTPUT_CAPACITY ? formatted.length() : OUTPUT_CAPACITY - 1;
+        memcpy(output, formatted.data(), length);
+        output[length] = '\0';
+        return static_cast<int>(length);
+#else
+        return snprintf(output, OUTPUT_CAPACITY, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+            static_cast<int>(fullName.length()), fullName.data());
+#endif
+    }
+
+    int Run(char* output)
+    {
+        return PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1, output) + PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2, output);
+    }
+}
+
+#if !defined(CString_BINARY)
+#define CString_BINARY nullptr
+#define EASTLString_BINARY nullptr
+#define StringView_BINARY nullptr
+#define StdString_BINARY nullptr
+#define StdStringView_BINARY nullptr
+#define StdPmrString_BINARY nullptr
+#define StdFormat_BINARY nullptr
+#endif
+
+struct Variant
+{
+    const char* label;
+    int (*run)(char* output);
+    // The matching example binary, for code size.
+    const char* binary;
+};
+
+const Variant VARIANTS[] =
+{
+    { "CString", CStringVariant::Run, CString_BINARY },
+    { "EASTLString", EASTLStringVariant::Run, EASTLString_BINARY },
+    { "StringView", StringViewVariant::Run, StringView_BINARY },
+    { "StdString", StdStringVariant::Run, StdString_BINARY },
+    { "StdStringView", StdStringViewVariant::Run, StdStringView_BINARY },
+    { "StdPmrString", StdPmrStringVariant::Run, StdPmrString_BINARY },
+#if defined(__cpp_lib_format)
+    { "StdFormat (std::format)", StdFormatVariant::Run, StdFormat_BINARY },
+#else
+    { "StdFormat (snprintf)", StdFormatVariant::Run, StdFormat_BINARY },
+#endif
+};
+
+int main(int argc, char** argv)
+{
+    size_t iterations = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    if (iterations == 0)
+    {
+        printf("Usage: StringBenchmark [iterations]\n");
+        return 1;
+    }
+
+    printf("%zu iterations of each example's two PrankMoe() calls\n", iterations);
+    printf("%-24s %10s %12s %12s %14s\n", "", "ns/iter", "allocs/iter", "text bytes", "PrankMoe bytes");
+
+    char output[OUTPUT_CAPACITY];
+    size_t totalLength = 0;
+    for (const Variant& variant : VARIANTS)
+    {
+        uint64_t allocationsBefore = gAllocations.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            totalLength += static_cast<size_t>(variant.run(output));
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        uint64_t allocations = gAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+        printf("%-24s %10.1f %12.2f", variant.label, nanoseconds, static_cast<double>(allocations) / static_cast<double>(iterations));
+
+        CodeSize size = {};
+        if (variant.binary != nullptr && ReadCodeSize(variant.binary, size))
+        {
+            printf(" %12zu %14zu\n", size.textBytes, size.prankMoeBytes);
+        }
+        else
+        {
+            printf(" %12s %14s\n", "-", "-");
+        }
+    }
+
+    printf("%zu bytes formatted\n", totalLength);
+    return 0;
+}
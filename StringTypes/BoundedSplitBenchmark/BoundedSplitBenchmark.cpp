@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "BoundedStringView.h"
+#include "PaddedBuffer.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// A mix of short, medium and the occasional long name.
+size_t MakeName(size_t index, char* buffer, size_t capacity)
+{
+    const char* format = index % 3 == 0 ? "%s %s" : index % 3 == 1 ? "%s %s of Springfield" : "%s %s of Springfield, Shelbyville and Capital City";
+    int length = snprintf(buffer, capacity, format, FIRST_NAMES[index % 10], SURNAMES[(index / 10) % 10]);
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+size_t FirstNameLength(size_t delimiterPosition, size_t length)
+{
+    return delimiterPosition != eastl::string_view::npos ? delimiterPosition : length;
+}
+
+template <typename Split>
+void Run(const char* label, size_t rounds, size_t nameCount, Split split)
+{
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        checksum += split();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double splits = static_cast<double>(nameCount * rounds);
+    printf("%-36s %6.2f ns/split  (checksum %zu)\n", label, std::chrono::duration<double, std::nano>(elapsed).count() / splits, checksum);
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    size_t rounds = argc > 2 ? strtoull(argv[2], nullptr, 10) : 100;
+    if (nameCount == 0 || rounds == 0)
+    {
+        printf("Usage: BoundedSplitBenchmark [nameCount] [rounds]\n");
+        return 1;
+    }
+
+    PaddedNamePool pool;
+    eastl::vector<eastl::string_view> names;
+    BoundedNameClasses classes;
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        char name[96];
+        eastl::string_view stored = pool.Append(eastl::string_view(name, MakeName(i, name, sizeof(name))));
+        names.push_back(stored);
+        classes.Add(stored);
+    }
+
+    printf("%zu names: %zu of up to 16 bytes, %zu of up to 32, %zu longer; %zu rounds\n", nameCount,
+        classes.GetShortNames().size(), classes.GetMediumNames().size(), classes.GetLongNames().size(), rounds);
+
+    Run("eastl::string_view::find(' ')", rounds, nameCount, [&]
+    {
+        size_t sum = 0;
+        for (eastl::string_view name : names)
+        {
+            sum += FirstNameLength(name.find(' '), name.length());
+        }
+        return sum;
+    });
+
+    Run("FindBounded(' ') per length class", rounds, nameCount, [&]
+    {
+        size_t sum = 0;
+        for (BoundedNameClasses::ShortName name : classes.GetShortNames())
+        {
+            sum += FirstNameLength(FindBounded(name, ' '), name.length());
+        }
+        for (BoundedNameClasses::MediumName name : classes.GetMediumNames())
+        {
+            sum += FirstNameLength(FindBounded(name, ' '), name.length());
+        }
+        for (eastl::string_view name : classes.GetLongNames())
+        {
+            sum += FirstNameLength(name.find(' '), name.length());
+        }
+        return sum;
+    });
+
+    BoundedNameClasses::ShortName fullName = classes.GetShortNames().front();
+    size_t firstNameLength = FirstNameLength(FindBounded(fullName, ' '), fullName.length());
+    printf(MOE_DIALOGUE_1, static_cast<int>(firstNameLength), fullName.data(), static_cast<int>(fullName.length()), fullName.data());
+
+    return 0;
+}
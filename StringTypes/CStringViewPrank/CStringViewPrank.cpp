@@ -0,0 +1,41 @@
+#include <iostream>
+#include <EASTL/string.h>
+#include "CStringView.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+// Plain %s conversions, as a C API would take them, rather than %.*s with a length.
+constexpr CStringView MOE_DIALOGUE_1 = "Hey, is there a %s here? Hey, everybody, I wanna %s!\n";
+constexpr CStringView MOE_DIALOGUE_2 = "Uh, %s? Hey, I'm lookin for %s!\n";
+
+constexpr const char* PRANK_NAME_1 = "Seymour Butz";
+constexpr CStringView PRANK_NAME_2 = "Amanda Hugginkiss";
+
+void PrankMoe(CStringView localised, CStringView fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+
+    // The full name is terminated already. The first name ends early, so it is terminated in a
+    // thread-local buffer for the duration of the call instead of being copied to an eastl::string.
+    printf(localised.c_str(), TerminatedString(fullName.substr(0, delimiterPosition)).c_str(), fullName.c_str());
+}
+
+int main()
+{
+    PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1);
+    PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2);
+
+    // A suffix ends where the original does, so it needs no copy at all.
+    CStringView surname = PRANK_NAME_2.Suffix(PRANK_NAME_2.find(' ') + 1);
+    printf("Moe is still looking for anyone called %s.\n", surname.c_str());
+
+    // C strings and eastl::strings are terminated too, so they pass straight through.
+    eastl::string caller = "Bart";
+    printf("%s is on the line about %s.\n", TerminatedString(caller).c_str(), TerminatedString(PRANK_NAME_1).c_str());
+    printf("%s hangs up.\n", TerminatedString("Moe").c_str());
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <EASTL/string.h>
+#include "LiteralString.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+// Unlike the eastl::string globals in EASTLString.cpp, these are constant initialized, point at
+// the literals themselves and have nothing to destroy at exit.
+LITERAL_CONSTINIT const TextLiteral MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+LITERAL_CONSTINIT const TextLiteral MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+LITERAL_CONSTINIT const TextLiteral PRANK_NAME_1 = "Seymour Butz";
+LITERAL_CONSTINIT const TextLiteral PRANK_NAME_2 = "Amanda Hugginkiss";
+
+void PrankMoe(const eastl::string& localised, const eastl::string& fullName)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    eastl::string outputName = delimiterPosition != eastl::string::npos ?
+        fullName.substr(0, delimiterPosition) : fullName;
+
+    printf(localised.data(), outputName.length(), outputName.data(), fullName.length(), fullName.data());
+}
+
+int main()
+{
+    // PrankMoe() still takes const eastl::string&, and that needs an eastl::string: the globals
+    // cost nothing at startup, but each call here copies them.
+    PrankMoe(MOE_DIALOGUE_1.ToString(), PRANK_NAME_1.ToString());
+    PrankMoe(MOE_DIALOGUE_2.ToString(), PRANK_NAME_2.ToString());
+
+    // A LiteralString copied from a literal shares it until it is changed.
+    LiteralString fullName = PRANK_NAME_2;
+    fullName.append(" Jr.");
+    PrankMoe(MOE_DIALOGUE_2.ToString(), fullName.ToString());
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <iostream>
+#include <EASTL/functional.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include "NameLiteral.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr eastl::string_view MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+constexpr eastl::string_view MOE_DIALOGUE_2 = "Uh, %.*s? Hey, I'm lookin for %.*s!\n";
+
+constexpr NameLiteral PRANK_NAME_1 = "Seymour Butz"_name;
+constexpr NameLiteral PRANK_NAME_2 = "Amanda Hugginkiss"_name;
+
+// Everything about the names is known before the program runs.
+static_assert(PRANK_NAME_1.GetDelimiterPosition() == 7, "Seymour");
+static_assert(PRANK_NAME_2.GetHash() == NameLiteral::Hash("Amanda Hugginkiss", 17), "hash");
+
+// No find(' '): the first name's length is a field of the literal.
+void PrankMoe(eastl::string_view localised, const NameLiteral& fullName)
+{
+    eastl::string_view outputName = fullName.GetFirstName();
+
+    printf(localised.data(), outputName.length(), outputName.data(), fullName.length(), fullName.data());
+}
+
+int main()
+{
+    PrankMoe(MOE_DIALOGUE_1, PRANK_NAME_1);
+    PrankMoe(MOE_DIALOGUE_2, PRANK_NAME_2);
+
+    eastl::hash_map<eastl::string, int> prankCounts;
+    prankCounts["Seymour Butz"] = 0;
+    prankCounts["Amanda Hugginkiss"] = 0;
+
+    for (const NameLiteral& fullName : { PRANK_NAME_1, PRANK_NAME_2 })
+    {
+        // The lookup uses the precomputed hash rather than hashing the name again.
+        auto it = prankCounts.find_as(fullName, NameHash(), eastl::equal_to_2<eastl::string, eastl::string_view>());
+        if (it != prankCounts.end())
+        {
+            ++it->second;
+        }
+    }
+
+    printf("Moe has been pranked by %d people\n", prankCounts["Seymour Butz"] + prankCounts["Amanda Hugginkiss"]);
+
+    return 0;
+}
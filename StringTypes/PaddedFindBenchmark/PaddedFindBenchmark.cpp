@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "PaddedBuffer.h"
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	return new uint8_t[size];
+}
+
+constexpr const char* MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// Short names, where the tail is most of the work.
+size_t MakeName(size_t index, char* buffer, size_t capacity)
+{
+    int length = snprintf(buffer, capacity, "%s %s", FIRST_NAMES[index % 10], SURNAMES[(index / 10) % 10]);
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+size_t PrankMoe(eastl::string_view fullName, size_t firstNameLength, char* buffer, size_t capacity)
+{
+    int length = snprintf(buffer, capacity, MOE_DIALOGUE_1, static_cast<int>(firstNameLength), fullName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+template <typename View, typename Find>
+void Run(const char* label, const eastl::vector<View>& names, size_t rounds, Find find)
+{
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (const View& name : names)
+        {
+            checksum += find(name);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double finds = static_cast<double>(names.size() * rounds);
+    printf("%-34s %6.2f ns/find  (checksum %zu)\n", label, std::chrono::duration<double, std::nano>(elapsed).count() / finds, checksum);
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    size_t rounds = argc > 2 ? strtoull(argv[2], nullptr, 10) : 100;
+    if (nameCount == 0 || rounds == 0)
+    {
+        printf("Usage: PaddedFindBenchmark [nameCount] [rounds]\n");
+        return 1;
+    }
+
+    PaddedNamePool pool;
+    eastl::vector<PaddedStringView> padded;
+    eastl::vector<eastl::string_view> plain;
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        char name[64];
+        PaddedStringView view = pool.Append(eastl::string_view(name, MakeName(i, name, sizeof(name))));
+        padded.push_back(view);
+        plain.push_back(view);
+    }
+
+    printf("%zu names, %zu rounds of first name splits\n", nameCount, rounds);
+    Run("eastl::string_view::find(' ')", plain, rounds, [](eastl::string_view name) { return name.find(' '); });
+    Run("FindPadded(' ')", padded, rounds, [](PaddedStringView name) { return FindPadded(name, ' '); });
+
+    char buffer[256];
+    PaddedStringView fullName = padded[0];
+    size_t delimiterPosition = FindPadded(fullName, ' ');
+    PrankMoe(fullName, delimiterPosition != PaddedStringView::npos ? delimiterPosition : fullName.length(), buffer, sizeof(buffer));
+    printf("%s", buffer);
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include "ScratchString.h"
+
+std::atomic<uint64_t> gAllocations{ 0 };
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	gAllocations.fetch_add(1, std::memory_order_relaxed);
+	return new uint8_t[size];
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+	gAllocations.fetch_add(1, std::memory_order_relaxed);
+	return new uint8_t[size];
+}
+
+constexpr eastl::string_view MOE_DIALOGUE_1 = "Hey, is there a %.*s here? Hey, everybody, I wanna %.*s!\n";
+
+constexpr const char* FIRST_NAMES[] = { "Seymour", "Amanda", "Hugh", "Ollie", "Homer", "Mike", "Jacques", "Ivana", "Anita", "Al" };
+constexpr const char* SURNAMES[] = { "Butz", "Hugginkiss", "Jass", "Tabooger", "Sexual", "Rotch", "Strap", "Tinkle", "Bath", "Coholic" };
+
+// One name in this many is a multi-kilobyte outlier, to exercise the scratch strings' trimming.
+constexpr size_t OUTLIER_INTERVAL = 50000;
+constexpr size_t OUTLIER_LENGTH = 8192;
+
+// As in EASTLString.cpp: the callee takes owning strings and builds the first name with substr().
+size_t PrankMoe(const eastl::string& localised, const eastl::string& fullName, char* buffer, size_t capacity)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    eastl::string outputName = delimiterPosition != eastl::string::npos ?
+        fullName.substr(0, delimiterPosition) : fullName;
+
+    int length = snprintf(buffer, capacity, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+// The same owning string API, with the first name assigned into a scratch string.
+size_t PrankMoeScratch(const eastl::string& localised, const eastl::string& fullName, char* buffer, size_t capacity)
+{
+    ScratchString outputName;
+    outputName->assign(fullName, 0, fullName.find(' '));
+
+    int length = snprintf(buffer, capacity, localised.data(), static_cast<int>(outputName->length()), outputName->data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+// As in StringView.cpp.
+size_t PrankMoeView(eastl::string_view localised, eastl::string_view fullName, char* buffer, size_t capacity)
+{
+    size_t delimiterPosition = fullName.find(' ');
+    eastl::string_view outputName = delimiterPosition != eastl::string_view::npos ?
+        fullName.substr(0, delimiterPosition) : fullName;
+
+    int length = snprintf(buffer, capacity, localised.data(), static_cast<int>(outputName.length()), outputName.data(),
+        static_cast<int>(fullName.length()), fullName.data());
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+template <typename Prank>
+void Run(const char* label, const eastl::vector<const char*>& names, size_t rounds, Prank prank)
+{
+    char buffer[256];
+    size_t bytes = 0;
+
+    uint64_t allocationsBefore = gAllocations.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (const char* name : names)
+        {
+            bytes += prank(name, buffer, sizeof(buffer));
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocations = gAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+    double calls = static_cast<double>(names.size() * rounds);
+    printf("%-40s %7.1f ns/call  %5.2f allocations/call  %zu bytes formatted\n", label,
+        std::chrono::duration<double, std::nano>(elapsed).count() / calls, static_cast<double>(allocations) / calls, bytes);
+}
+
+int main(int argc, char** argv)
+{
+    size_t nameCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 200000;
+    size_t rounds = argc > 2 ? strtoull(argv[2], nullptr, 10) : 10;
+    if (nameCount == 0 || rounds == 0)
+    {
+        printf("Usage: ScratchStringBenchmark [nameCount] [rounds]\n");
+        return 1;
+    }
+
+    eastl::vector<eastl::string> storage;
+    storage.reserve(nameCount);
+    for (size_t i = 0; i < nameCount; ++i)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "%s%zu %s of Springfield", FIRST_NAMES[i % 10], i, SURNAMES[(i / 10) % 10]);
+        storage.push_back(name);
+        if (i % OUTLIER_INTERVAL == OUTLIER_INTERVAL - 1)
+        {
+            storage.back().append(OUTLIER_LENGTH, 'z');
+        }
+    }
+
+    eastl::vector<const char*> names;
+    for (const eastl::string& name : storage)
+    {
+        names.push_back(name.c_str());
+    }
+
+    const eastl::string localised(MOE_DIALOGUE_1.data(), MOE_DIALOGUE_1.length());
+
+    printf("%zu names, %zu rounds\n", nameCount, rounds);
+    Run("eastl::string temporaries and substr()", names, rounds, [&](const char* name, char* buffer, size_t capacity)
+    {
+        return PrankMoe(localised, name, buffer, capacity);
+    });
+    Run("ScratchString", names, rounds, [&](const char* name, char* buffer, size_t capacity)
+    {
+        ScratchString fullName;
+        fullName->assign(name);
+        return PrankMoeScratch(localised, *fullName, buffer, capacity);
+    });
+    Run("eastl::string_view", names, rounds, [&](const char* name, char* buffer, size_t capacity)
+    {
+        return PrankMoeView(MOE_DIALOGUE_1, name, buffer, capacity);
+    });
+
+    ScratchString::Stats stats = ScratchString::GetStats();
+    printf("Scratch strings: %llu leases, %llu overflowed the pool, %llu trimmed after outliers\n",
+        static_cast<unsigned long long>(stats.leases), static_cast<unsigned long long>(stats.overflowLeases),
+        static_cast<unsigned long long>(stats.shrinks));
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// SSE2 is part of x86-64 and of 32-bit x86 builds that ask for it. Code that scans strings 16
+// bytes at a time checks SIMD_USE_SSE2 and keeps a scalar path for everything else.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_USE_SSE2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// The line size of every x86-64 and most ARM cores, for laying data out so that a block or a
+// group of nodes is fetched in one go.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Index of the lowest set bit, eg. the first matching byte in a _mm_movemask_epi8 mask. 'mask'
+// must not be zero.
+inline uint32_t CountTrailingZeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+}
+
+inline uint32_t CountTrailingZeros(uint64_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return index;
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(mask));
+#endif
+}
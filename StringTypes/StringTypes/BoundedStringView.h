@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <EASTL/string.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/vector.h>
+#include "BitUtilities.h"
+
+// Whole-register loads in FindBounded() may read past the end of a string but never into another
+// page. AddressSanitizer cannot tell the difference, so the kernel opts out of it.
+#if defined(__clang__) || defined(__GNUC__)
+#define BOUNDED_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define BOUNDED_NO_SANITIZE_ADDRESS
+#endif
+
+// A string view whose length is at most N, with N part of the type. Code can be specialized on the
+// bound: FindBounded() splits any name of 32 bytes or fewer with one or two vector compares and no
+// loop. Converts implicitly to eastl::string_view and explicitly from it.
+template <size_t N>
+class BoundedStringView
+{
+public:
+    static constexpr size_t MAX_LENGTH = N;
+    static constexpr size_t npos = eastl::string_view::npos;
+
+    constexpr BoundedStringView() : mData(""), mLength(0) {}
+
+    // 'text' must fit; longer text is cut to N characters. Use TryMake() when it may not fit.
+    constexpr explicit BoundedStringView(eastl::string_view text)
+        : mData(text.data()), mLength(text.length() < N ? text.length() : N) {}
+
+    static constexpr bool Fits(eastl::string_view text) { return text.length() <= N; }
+
+    static bool TryMake(eastl::string_view text, BoundedStringView& view)
+    {
+        if (!Fits(text))
+        {
+            return false;
+        }
+        view = BoundedStringView(text);
+        return true;
+    }
+
+    // A view of a shorter bound always fits in a longer one.
+    template <size_t M, typename = typename eastl::enable_if<(M <= N)>::type>
+    constexpr BoundedStringView(BoundedStringView<M> other) : mData(other.data()), mLength(other.length()) {}
+
+    constexpr const char* data() const { return mData; }
+    constexpr size_t length() const { return mLength; }
+    constexpr size_t size() const { return mLength; }
+    constexpr bool empty() const { return mLength == 0; }
+
+    constexpr BoundedStringView substr(size_t position = 0, size_t count = npos) const
+    {
+        return BoundedStringView(eastl::string_view(mData, mLength).substr(position, count));
+    }
+
+    constexpr operator eastl::string_view() const { return eastl::string_view(mData, mLength); }
+
+private:
+    const char* mData;
+    size_t mLength;
+};
+
+constexpr size_t BOUNDED_PAGE_SIZE = 4096;
+
+// Position of the first 'c' in 'text', or npos. For N up to 32 this is one or two 16 byte compares
+// masked to the length; the only branch is the rarely taken copy for a string near the end of a page.
+template <size_t N>
+BOUNDED_NO_SANITIZE_ADDRESS size_t FindBounded(BoundedStringView<N> text, char c)
+{
+#if defined(SIMD_USE_SSE2)
+    if constexpr (N <= 32)
+    {
+        constexpr size_t LOAD_SIZE = N <= 16 ? 16 : 32;
+
+        const char* data = text.data();
+        alignas(16) char copy[LOAD_SIZE];
+        if ((reinterpret_cast<uintptr_t>(data) & (BOUNDED_PAGE_SIZE - 1)) > BOUNDED_PAGE_SIZE - LOAD_SIZE)
+        {
+            memset(copy, 0, LOAD_SIZE);
+            memcpy(copy, data, text.length());
+            data = copy;
+        }
+
+        const __m128i needle = _mm_set1_epi8(c);
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), needle)));
+        if constexpr (LOAD_SIZE == 32)
+        {
+            mask |= static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), needle))) << 16;
+        }
+
+        // Drop matches past the end of the string.
+        mask &= static_cast<uint32_t>((uint64_t(1) << text.length()) - 1);
+        return mask != 0 ? CountTrailingZeros(mask) : BoundedStringView<N>::npos;
+    }
+#endif
+    return eastl::string_view(text).find(c);
+}
+
+// Sorts names by length into bounded classes at ingestion time, so that each class can be
+// processed with a kernel specialized for its bound. Names longer than the largest bound are kept
+// as plain views. The views point at the caller's storage.
+class BoundedNameClasses
+{
+public:
+    typedef BoundedStringView<16> ShortName;
+    typedef BoundedStringView<32> MediumName;
+
+    void Add(eastl::string_view name)
+    {
+        if (ShortName::Fits(name))
+        {
+            mShortNames.push_back(ShortName(name));
+        }
+        else if (MediumName::Fits(name))
+        {
+            mMediumNames.push_back(MediumName(name));
+        }
+        else
+        {
+            mLongNames.push_back(name);
+        }
+    }
+
+    const eastl::vector<ShortName>& GetShortNames() const { return mShortNames; }
+    const eastl::vector<MediumName>& GetMediumNames() const { return mMediumNames; }
+    const eastl::vector<eastl::string_view>& GetLongNames() const { return mLongNames; }
+
+private:
+    eastl::vector<ShortName> mShortNames;
+    eastl::vector<MediumName> mMediumNames;
+    eastl::vector<eastl::string_view> mLongNames;
+};
@@ -0,0 +1,44 @@
+#include "CStringView.h"
+
+#include <cstring>
+
+namespace
+{
+    struct TerminatedBuffer
+    {
+        char bytes[TerminatedString::BUFFER_SIZE];
+        size_t used = 0;
+    };
+
+    thread_local TerminatedBuffer tBuffer;
+}
+
+TerminatedString::TerminatedString(eastl::string_view text)
+{
+    TerminatedBuffer& buffer = tBuffer;
+    size_t size = text.length() + 1;
+    if (size <= sizeof(buffer.bytes) - buffer.used)
+    {
+        char* copy = buffer.bytes + buffer.used;
+        if (text.length() > 0)
+        {
+            memcpy(copy, text.data(), text.length());
+        }
+        copy[text.length()] = '\0';
+
+        buffer.used += size;
+        mLeased = size;
+        mText = copy;
+    }
+    else
+    {
+        mOverflow.assign(text.data(), text.length());
+        mLeased = 0;
+        mText = mOverflow.c_str();
+    }
+}
+
+TerminatedString::~TerminatedString()
+{
+    tBuffer.used -= mLeased;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <EASTL/string.h>
+
+// A view of a string that is known to be null terminated, so c_str() can go straight to C APIs.
+// eastl::string_view makes no such promise: the data() of a substr() runs on to the end of the
+// original string. A CStringView only comes from sources that are terminated (literals, C strings,
+// eastl::strings) and only produces suffixes, which end where the original does. Substrings that
+// end early are plain eastl::string_views; TerminatedString gives them a terminator when needed.
+class CStringView
+{
+public:
+    static constexpr size_t npos = eastl::string_view::npos;
+
+    constexpr CStringView() : mData(""), mLength(0) {}
+
+    // constexpr so that a view of a literal is measured at compile time.
+    constexpr CStringView(const char* text) : mData(text), mLength(Measure(text)) {}
+    CStringView(const eastl::string& text) : mData(text.c_str()), mLength(text.length()) {}
+
+    // For callers that know 'data[length]' is a null terminator.
+    static constexpr CStringView FromTerminated(const char* data, size_t length) { return CStringView(data, length, 0); }
+
+    constexpr const char* c_str() const { return mData; }
+    constexpr const char* data() const { return mData; }
+    constexpr size_t length() const { return mLength; }
+    constexpr size_t size() const { return mLength; }
+    constexpr bool empty() const { return mLength == 0; }
+
+    size_t find(char c, size_t position = 0) const { return View().find(c, position); }
+    size_t find(eastl::string_view text, size_t position = 0) const { return View().find(text, position); }
+    size_t rfind(char c, size_t position = npos) const { return View().rfind(c, position); }
+
+    // Everything from 'position' on, still terminated.
+    constexpr CStringView Suffix(size_t position) const
+    {
+        return position < mLength ? CStringView(mData + position, mLength - position, 0) : CStringView(mData + mLength, 0, 0);
+    }
+
+    // Any other substring may end early, so it is returned as an ordinary view.
+    eastl::string_view substr(size_t position = 0, size_t count = npos) const { return View().substr(position, count); }
+
+    constexpr operator eastl::string_view() const { return View(); }
+
+private:
+    constexpr CStringView(const char* data, size_t length, int) : mData(data), mLength(length) {}
+
+    static constexpr size_t Measure(const char* text)
+    {
+        size_t length = 0;
+        while (text[length] != '\0')
+        {
+            ++length;
+        }
+        return length;
+    }
+
+    constexpr eastl::string_view View() const { return eastl::string_view(mData, mLength); }
+
+    const char* mData;
+    size_t mLength;
+};
+
+// A null terminated copy of a view, for handing a prefix or middle of a string to a C API. Short
+// strings are copied into a thread-local buffer, so there is no heap allocation; only text that
+// does not fit in what is left of the buffer goes to the heap. C strings, eastl::strings and
+// CStringViews are terminated already, so they are passed through without copying; each has its
+// own constructor, which also keeps literals and eastl::strings from being ambiguous between the
+// eastl::string_view and CStringView conversions.
+//
+// Meant to be used as a temporary, or scoped like one: instances on a thread must be destroyed in
+// the reverse order they were created, which temporaries in one expression always are.
+//
+//     printf("%s\n", TerminatedString(fullName.substr(0, delimiterPosition)).c_str());
+class TerminatedString
+{
+public:
+    static constexpr size_t BUFFER_SIZE = 4096;
+
+    explicit TerminatedString(eastl::string_view text);
+    explicit TerminatedString(CStringView text) : mText(text.c_str()), mLeased(0) {}
+    explicit TerminatedString(const char* text) : mText(text), mLeased(0) {}
+    explicit TerminatedString(const eastl::string& text) : mText(text.c_str()), mLeased(0) {}
+    ~TerminatedString();
+
+    TerminatedString(const TerminatedString&) = delete;
+    TerminatedString& operator=(const TerminatedString&) = delete;
+
+    const char* c_str() const { return mText; }
+
+private:
+    const char* mText;
+    size_t mLeased;
+    eastl::string mOverflow;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <EASTL/vector.h>
+
+// Appends 'value' as a LEB128 varint: 7 bits per byte, low bits first, with the high bit set on
+// every byte but the last. Lengths under 128 take a single byte. 'Byte' is char or uint8_t.
+template <typename Byte>
+void WriteVarint(eastl::vector<Byte>& data, size_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<Byte>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<Byte>(value));
+}
+
+// Reads a varint written by WriteVarint() at data[offset] and moves 'offset' past it.
+template <typename Byte>
+size_t ReadVarint(const Byte* data, size_t& offset)
+{
+    size_t value = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = static_cast<uint8_t>(data[offset++]);
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while ((byte & 0x80) != 0);
+    return value;
+}
+
+// Copies the part of 'source' that lands below 'capacity' when written at 'position'.
+inline void CopyClamped(char* buffer, size_t capacity, size_t position, const void* source, size_t count)
+{
+    if (position < capacity)
+    {
+        size_t available = capacity - position;
+        memcpy(buffer + position, source, count < available ? count : available);
+    }
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <EASTL/string.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+
+// Asks the compiler to check that a TextLiteral global is constant initialized. Constant
+// initialization happens without it too, as the literal constructor is constexpr.
+#if defined(__cpp_constinit)
+#define LITERAL_CONSTINIT constinit
+#else
+#define LITERAL_CONSTINIT
+#endif
+
+// Read-only text that points at a string literal. It has a constexpr constructor and is
+// trivially destructible, so a global is constant initialized: no heap allocation and no dynamic
+// initializer or registered destructor, and the bytes stay in read-only data. Copy it into a
+// LiteralString to get a string that can change, or call ToString() for an API that takes a
+// const eastl::string&.
+class TextLiteral
+{
+public:
+    typedef char value_type;
+    typedef eastl::string::size_type size_type;
+    typedef const char* const_iterator;
+
+    static constexpr size_type npos = eastl::string::npos;
+
+    constexpr TextLiteral() : mLiteral(""), mLength(0) {}
+
+    template <size_t N>
+    constexpr TextLiteral(const char (&literal)[N]) : mLiteral(literal), mLength(N - 1) {}
+
+    // A writable array is not a literal and may not outlive the text.
+    template <size_t N>
+    TextLiteral(char (&buffer)[N]) = delete;
+
+    constexpr const char* data() const { return mLiteral; }
+    constexpr const char* c_str() const { return mLiteral; }
+    constexpr size_type length() const { return mLength; }
+    constexpr size_type size() const { return mLength; }
+    constexpr bool empty() const { return mLength == 0; }
+
+    constexpr const_iterator begin() const { return mLiteral; }
+    constexpr const_iterator end() const { return mLiteral + mLength; }
+    constexpr char operator[](size_type position) const { return mLiteral[position]; }
+
+    size_type find(char c, size_type position = 0) const { return View().find(c, position); }
+    size_type find(eastl::string_view text, size_type position = 0) const { return View().find(text, position); }
+    size_type rfind(char c, size_type position = npos) const { return View().rfind(c, position); }
+    int compare(eastl::string_view text) const { return View().compare(text); }
+
+    // Like eastl::string, a substring is a new owning string.
+    eastl::string substr(size_type position = 0, size_type count = npos) const
+    {
+        eastl::string_view part = View().substr(position, count);
+        return eastl::string(part.data(), part.length());
+    }
+
+    // A const eastl::string& can only refer to an eastl::string, which owns its bytes, so this
+    // is a copy. Prefer taking eastl::string_view in new code.
+    eastl::string ToString() const { return eastl::string(mLiteral, mLength); }
+
+    operator eastl::string_view() const { return View(); }
+
+private:
+    eastl::string_view View() const { return eastl::string_view(mLiteral, mLength); }
+
+    const char* mLiteral;
+    size_type mLength;
+};
+
+static_assert(eastl::is_trivially_destructible<TextLiteral>::value, "TextLiteral globals must not register a destructor");
+
+// An owning string that starts out pointing at a string literal or a TextLiteral. Copies share
+// the literal too. The first mutation copies the bytes into an eastl::string held inline, after
+// which it behaves exactly like one. It has a destructor for that string, so globals should be
+// TextLiterals: a LiteralString global is constant initialized but still registers its
+// destructor at startup.
+//
+// Read access follows eastl::string. Mutable element access (non-const data() or operator[]) is
+// left out, so that reading a string never copies it by accident. For the same reason it does
+// not convert to const eastl::string& implicitly: ToString() makes the copy that takes.
+class LiteralString
+{
+public:
+    typedef char value_type;
+    typedef eastl::string::size_type size_type;
+    typedef const char* const_iterator;
+
+    static constexpr size_type npos = eastl::string::npos;
+
+    constexpr LiteralString() : mLiteral(""), mLiteralLength(0) {}
+
+    template <size_t N>
+    constexpr LiteralString(const char (&literal)[N]) : mLiteral(literal), mLiteralLength(N - 1) {}
+
+    constexpr LiteralString(TextLiteral literal) : mLiteral(literal.data()), mLiteralLength(literal.length()) {}
+
+    // A writable array is not a literal and may not outlive the string.
+    template <size_t N>
+    LiteralString(char (&buffer)[N]) = delete;
+
+    // Copies 'text', which need not outlive the string.
+    explicit LiteralString(eastl::string_view text)
+    {
+        new (mStorage) eastl::string(text.data(), text.length());
+        mOwned = true;
+    }
+
+    LiteralString(const LiteralString& other) : mLiteral(other.mLiteral), mLiteralLength(other.mLiteralLength)
+    {
+        if (other.mOwned)
+        {
+            new (mStorage) eastl::string(other.GetOwned());
+            mOwned = true;
+        }
+    }
+
+    LiteralString(LiteralString&& other) : mLiteral(other.mLiteral), mLiteralLength(other.mLiteralLength)
+    {
+        if (other.mOwned)
+        {
+            new (mStorage) eastl::string(eastl::move(other.GetOwned()));
+            mOwned = true;
+        }
+    }
+
+    ~LiteralString()
+    {
+        Release();
+    }
+
+    LiteralString& operator=(const LiteralString& other)
+    {
+        if (this != &other)
+        {
+            this->~LiteralString();
+            new (this) LiteralString(other);
+        }
+        return *this;
+    }
+
+    LiteralString& operator=(LiteralString&& other)
+    {
+        if (this != &other)
+        {
+            this->~LiteralString();
+            new (this) LiteralString(eastl::move(other));
+        }
+        return *this;
+    }
+
+    // Read access.
+    const char* data() const { return mOwned ? GetOwned().data() : mLiteral; }
+    const char* c_str() const { return data(); }
+    size_type length() const { return mOwned ? GetOwned().length() : mLiteralLength; }
+    size_type size() const { return length(); }
+    bool empty() const { return length() == 0; }
+
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + length(); }
+    char operator[](size_type position) const { return data()[position]; }
+    char front() const { return data()[0]; }
+    char back() const { return data()[length() - 1]; }
+
+    size_type find(char c, size_type position = 0) const { return View().find(c, position); }
+    size_type find(eastl::string_view text, size_type position = 0) const { return View().find(text, position); }
+    size_type rfind(char c, size_type position = npos) const { return View().rfind(c, position); }
+    int compare(eastl::string_view text) const { return View().compare(text); }
+
+    // Like eastl::string, a substring is a new owning string.
+    eastl::string substr(size_type position = 0, size_type count = npos) const
+    {
+        eastl::string_view part = View().substr(position, count);
+        return eastl::string(part.data(), part.length());
+    }
+
+    eastl::string ToString() const { return mOwned ? GetOwned() : eastl::string(mLiteral, mLiteralLength); }
+
+    operator eastl::string_view() const { return View(); }
+
+    // Mutation. Each of these moves a literal-backed string to its own buffer first.
+    LiteralString& append(eastl::string_view text) { MakeOwned().append(text.data(), text.length()); return *this; }
+    LiteralString& append(size_type count, char c) { MakeOwned().append(count, c); return *this; }
+    LiteralString& assign(eastl::string_view text) { MakeOwned().assign(text.data(), text.length()); return *this; }
+    LiteralString& insert(size_type position, eastl::string_view text) { MakeOwned().insert(position, text.data(), text.length()); return *this; }
+    LiteralString& erase(size_type position = 0, size_type count = npos) { MakeOwned().erase(position, count); return *this; }
+    LiteralString& operator+=(eastl::string_view text) { return append(text); }
+    LiteralString& operator+=(char c) { push_back(c); return *this; }
+    void push_back(char c) { MakeOwned().push_back(c); }
+    void resize(size_type count) { MakeOwned().resize(count); }
+    void reserve(size_type capacity) { MakeOwned().reserve(capacity); }
+
+    // Clearing needs no buffer, so an unshared empty literal is used instead.
+    void clear()
+    {
+        Release();
+        mLiteral = "";
+        mLiteralLength = 0;
+    }
+
+    // True while the string still points at its literal.
+    bool IsLiteral() const { return !mOwned; }
+
+private:
+    eastl::string_view View() const { return eastl::string_view(data(), length()); }
+
+    eastl::string& GetOwned() { return *std::launder(reinterpret_cast<eastl::string*>(mStorage)); }
+    const eastl::string& GetOwned() const { return *std::launder(reinterpret_cast<const eastl::string*>(mStorage)); }
+
+    eastl::string& MakeOwned()
+    {
+        if (!mOwned)
+        {
+            new (mStorage) eastl::string(mLiteral, mLiteralLength);
+            mOwned = true;
+        }
+        return GetOwned();
+    }
+
+    void Release()
+    {
+        if (mOwned)
+        {
+            GetOwned().~basic_string();
+            mOwned = false;
+        }
+    }
+
+    const char* mLiteral = "";
+    size_type mLiteralLength = 0;
+    bool mOwned = false;
+
+    // Holds the eastl::string once the string has been mutated.
+    alignas(eastl::string) unsigned char mStorage[sizeof(eastl::string)] = {};
+};
+
+inline bool operator==(const LiteralString& a, eastl::string_view b) { return a.compare(b) == 0; }
+inline bool operator!=(const LiteralString& a, eastl::string_view b) { return a.compare(b) != 0; }
+inline bool operator<(const LiteralString& a, const LiteralString& b) { return a.compare(b) < 0; }
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+
+// A name known at compile time, together with facts about it that would otherwise be recomputed
+// on every use: its length, its hash and the position of the first space. Written as
+// "Seymour Butz"_name and stored in a constexpr variable, all three are computed by the compiler,
+// so splitting the name or looking it up in a hash map reads a field instead of scanning.
+class NameLiteral
+{
+public:
+    static constexpr size_t npos = eastl::string_view::npos;
+
+    constexpr NameLiteral(const char* data, size_t length)
+        : mData(data), mLength(length), mHash(Hash(data, length)), mDelimiterPosition(FindDelimiter(data, length)) {}
+
+    constexpr const char* data() const { return mData; }
+    constexpr size_t length() const { return mLength; }
+
+    // Equal to eastl::hash<eastl::string_view> (and so eastl::hash<eastl::string>) of the name.
+    constexpr size_t GetHash() const { return mHash; }
+
+    // Position of the first space, or npos.
+    constexpr size_t GetDelimiterPosition() const { return mDelimiterPosition; }
+
+    constexpr eastl::string_view GetFirstName() const
+    {
+        return eastl::string_view(mData, mDelimiterPosition != npos ? mDelimiterPosition : mLength);
+    }
+
+    constexpr operator eastl::string_view() const { return eastl::string_view(mData, mLength); }
+
+    // The FNV-1 variant used by EASTL's string hashes.
+    static constexpr size_t Hash(const char* data, size_t length)
+    {
+        uint32_t result = 2166136261U;
+        for (size_t i = 0; i < length; ++i)
+        {
+            result = (result * 16777619) ^ static_cast<uint8_t>(data[i]);
+        }
+        return static_cast<size_t>(result);
+    }
+
+private:
+    static constexpr size_t FindDelimiter(const char* data, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (data[i] == ' ')
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    const char* mData;
+    size_t mLength;
+    size_t mHash;
+    size_t mDelimiterPosition;
+};
+
+constexpr NameLiteral operator""_name(const char* text, size_t length)
+{
+    return NameLiteral(text, length);
+}
+
+// Hashes names for maps keyed by eastl::string or eastl::string_view. A NameLiteral passed to
+// find_as() uses its precomputed hash; anything else is hashed as eastl::hash would.
+//
+//     names.find_as("Seymour Butz"_name, NameHash(), eastl::equal_to_2<eastl::string, eastl::string_view>());
+struct NameHash
+{
+    size_t operator()(const NameLiteral& name) const { return name.GetHash(); }
+    size_t operator()(eastl::string_view name) const { return NameLiteral::Hash(name.data(), name.length()); }
+};
@@ -0,0 +1,108 @@
+#include "PaddedBuffer.h"
+
+#include <cstdlib>
+#include <cstring>
+#include "BitUtilities.h"
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    // Allocates 'size' usable bytes followed by SIMD_PADDING bytes, all zeroed so that kernels
+    // reading past a string never see uninitialized memory.
+    char* AllocatePadded(size_t size)
+    {
+        size_t total = size + SIMD_PADDING;
+#if defined(_WIN32)
+        char* memory = static_cast<char*>(_aligned_malloc(total, SIMD_ALIGNMENT));
+#else
+        void* allocation = nullptr;
+        char* memory = posix_memalign(&allocation, SIMD_ALIGNMENT, total) == 0 ? static_cast<char*>(allocation) : nullptr;
+#endif
+        if (memory != nullptr)
+        {
+            memset(memory, 0, total);
+        }
+        return memory;
+    }
+
+    void FreePadded(char* memory)
+    {
+#if defined(_WIN32)
+        _aligned_free(memory);
+#else
+        free(memory);
+#endif
+    }
+}
+
+size_t FindPadded(PaddedStringView text, char c)
+{
+    const char* data = text.data();
+    size_t length = text.length();
+
+#if defined(SIMD_USE_SSE2)
+    const __m128i needle = _mm_set1_epi8(c);
+    for (size_t offset = 0; offset < length; offset += 16)
+    {
+        // May read up to 15 bytes past the end, which the padding makes safe.
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, needle)));
+        if (mask != 0)
+        {
+            size_t position = offset + CountTrailingZeros(mask);
+            return position < length ? position : PaddedStringView::npos;
+        }
+    }
+    return PaddedStringView::npos;
+#else
+    const void* found = length > 0 ? memchr(data, c, length) : nullptr;
+    return found != nullptr ? static_cast<size_t>(static_cast<const char*>(found) - data) : PaddedStringView::npos;
+#endif
+}
+
+PaddedBuffer::PaddedBuffer(size_t capacity) : mData(AllocatePadded(capacity)), mCapacity(mData != nullptr ? capacity : 0)
+{
+}
+
+PaddedBuffer::~PaddedBuffer()
+{
+    FreePadded(mData);
+}
+
+PaddedNamePool::~PaddedNamePool()
+{
+    for (char* chunk : mChunks)
+    {
+        FreePadded(chunk);
+    }
+}
+
+PaddedStringView PaddedNamePool::Append(eastl::string_view name)
+{
+    if (static_cast<size_t>(mEnd - mCursor) < name.length())
+    {
+        size_t size = name.length() > CHUNK_SIZE ? name.length() : CHUNK_SIZE;
+        char* chunk = AllocatePadded(size);
+        if (chunk == nullptr)
+        {
+            return PaddedStringView();
+        }
+
+        mChunks.push_back(chunk);
+        mCursor = chunk;
+        mEnd = chunk + size;
+        mReservedBytes += size + SIMD_PADDING;
+    }
+
+    char* storage = mCursor;
+    if (name.length() > 0)
+    {
+        memcpy(storage, name.data(), name.length());
+    }
+    mCursor += name.length();
+    ++mCount;
+    return PaddedStringView(storage, name.length());
+}
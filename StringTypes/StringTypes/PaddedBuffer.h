@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+// Bytes after the end of every PaddedStringView that are guaranteed to be readable.
+constexpr size_t SIMD_PADDING = 64;
+// Alignment of the start of every padded buffer and pool chunk.
+constexpr size_t SIMD_ALIGNMENT = 64;
+
+// A view into a PaddedBuffer or PaddedNamePool. The type is the guarantee: at least SIMD_PADDING
+// bytes past the end of the view can be read, so a vectorized kernel may load full registers
+// without checking for a tail or a page boundary. The bytes past the end belong to other strings
+// or to padding and must be ignored. Any substring keeps the guarantee.
+class PaddedStringView
+{
+public:
+    static constexpr size_t npos = eastl::string_view::npos;
+
+    constexpr PaddedStringView() : mData(EMPTY), mLength(0) {}
+
+    const char* data() const { return mData; }
+    size_t length() const { return mLength; }
+    size_t size() const { return mLength; }
+    bool empty() const { return mLength == 0; }
+
+    PaddedStringView substr(size_t position = 0, size_t count = npos) const
+    {
+        position = position < mLength ? position : mLength;
+        count = count < mLength - position ? count : mLength - position;
+        return PaddedStringView(mData + position, count);
+    }
+
+    operator eastl::string_view() const { return eastl::string_view(mData, mLength); }
+
+private:
+    friend class PaddedBuffer;
+    friend class PaddedNamePool;
+
+    // Padding for the empty view.
+    alignas(SIMD_ALIGNMENT) static constexpr char EMPTY[SIMD_PADDING] = {};
+
+    constexpr PaddedStringView(const char* data, size_t length) : mData(data), mLength(length) {}
+
+    const char* mData;
+    size_t mLength;
+};
+
+// Position of the first 'c' in 'text', or npos. Loads 16 bytes at a time and relies on the
+// padding instead of handling the tail separately.
+size_t FindPadded(PaddedStringView text, char c);
+
+// A single aligned, padded allocation.
+class PaddedBuffer
+{
+public:
+    explicit PaddedBuffer(size_t capacity);
+    ~PaddedBuffer();
+
+    PaddedBuffer(const PaddedBuffer&) = delete;
+    PaddedBuffer& operator=(const PaddedBuffer&) = delete;
+
+    char* data() { return mData; }
+    size_t capacity() const { return mCapacity; }
+
+    // A view of the first 'length' bytes, which must be within the capacity.
+    PaddedStringView GetView(size_t length) const { return PaddedStringView(mData, length < mCapacity ? length : mCapacity); }
+
+private:
+    char* mData;
+    size_t mCapacity;
+};
+
+// Append-only storage for names, packed back to back in aligned chunks that end in SIMD_PADDING
+// zero bytes, so every name handed out is a PaddedStringView.
+class PaddedNamePool
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    PaddedNamePool() = default;
+    ~PaddedNamePool();
+
+    PaddedNamePool(const PaddedNamePool&) = delete;
+    PaddedNamePool& operator=(const PaddedNamePool&) = delete;
+
+    PaddedStringView Append(eastl::string_view name);
+
+    size_t GetCount() const { return mCount; }
+    size_t GetReservedBytes() const { return mReservedBytes; }
+
+private:
+    eastl::vector<char*> mChunks;
+    char* mCursor = nullptr;
+    char* mEnd = nullptr;
+    size_t mCount = 0;
+    size_t mReservedBytes = 0;
+};
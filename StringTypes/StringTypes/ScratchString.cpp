@@ -0,0 +1,75 @@
+#include "ScratchString.h"
+
+namespace
+{
+    struct ScratchSlot
+    {
+        eastl::string string;
+        size_t windowPeak = 0;
+        uint32_t windowLeases = 0;
+    };
+
+    struct ScratchPool
+    {
+        ScratchSlot slots[ScratchString::POOL_SIZE];
+        uint32_t depth = 0;
+        ScratchString::Stats stats = {};
+    };
+
+    thread_local ScratchPool tPool;
+
+    void Release(ScratchSlot& slot)
+    {
+        size_t length = slot.string.length();
+        slot.windowPeak = length > slot.windowPeak ? length : slot.windowPeak;
+        slot.string.clear();
+
+        if (++slot.windowLeases < ScratchString::SHRINK_WINDOW)
+        {
+            return;
+        }
+
+        size_t wanted = slot.windowPeak > ScratchString::RETAINED_CAPACITY ? slot.windowPeak : ScratchString::RETAINED_CAPACITY;
+        if (slot.string.capacity() > wanted * 2)
+        {
+            slot.string.set_capacity(wanted);
+            ++tPool.stats.shrinks;
+        }
+
+        slot.windowPeak = 0;
+        slot.windowLeases = 0;
+    }
+}
+
+// Leases are scoped and cannot be moved, so they end in the reverse order they began and the pool
+// can be handed out as a stack.
+ScratchString::ScratchString()
+{
+    ScratchPool& pool = tPool;
+    ++pool.stats.leases;
+    if (pool.depth < POOL_SIZE)
+    {
+        mSlot = pool.depth++;
+        mString = &pool.slots[mSlot].string;
+    }
+    else
+    {
+        ++pool.stats.overflowLeases;
+        mSlot = POOL_SIZE;
+        mString = &mOverflow;
+    }
+}
+
+ScratchString::~ScratchString()
+{
+    if (mSlot < POOL_SIZE)
+    {
+        Release(tPool.slots[mSlot]);
+        --tPool.depth;
+    }
+}
+
+ScratchString::Stats ScratchString::GetStats()
+{
+    return tPool.stats;
+}
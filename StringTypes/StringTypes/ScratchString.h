@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <EASTL/string.h>
+
+// A lease on one of the calling thread's scratch eastl::strings, for code that has to hand an
+// owning string to an API but only needs it for the duration of a call. Instead of constructing a
+// new string (and allocating once it outgrows the small string buffer), assign into a scratch
+// string, whose capacity is kept from one lease to the next:
+//
+//     ScratchString firstName;
+//     firstName->assign(fullName, 0, fullName.find(' '));
+//
+// The string is cleared when the lease ends. If a lease used far less than the string's capacity
+// for a whole window of leases, the capacity is trimmed, so one outlier does not pin a large
+// buffer for the life of the thread. Leases nest up to POOL_SIZE deep; deeper leases fall back to
+// an ordinary string. A lease must not be used on another thread.
+class ScratchString
+{
+public:
+    static constexpr uint32_t POOL_SIZE = 8;
+    // Capacity that is never trimmed.
+    static constexpr size_t RETAINED_CAPACITY = 1024;
+    static constexpr uint32_t SHRINK_WINDOW = 256;
+
+    struct Stats
+    {
+        uint64_t leases;
+        uint64_t overflowLeases;
+        uint64_t shrinks;
+    };
+
+    ScratchString();
+    ~ScratchString();
+
+    ScratchString(const ScratchString&) = delete;
+    ScratchString& operator=(const ScratchString&) = delete;
+
+    eastl::string& Get() { return *mString; }
+    const eastl::string& Get() const { return *mString; }
+
+    eastl::string& operator*() { return *mString; }
+    eastl::string* operator->() { return mString; }
+    operator const eastl::string&() const { return *mString; }
+
+    // Counters for the calling thread.
+    static Stats GetStats();
+
+private:
+    eastl::string* mString;
+    uint32_t mSlot;
+
+    // Only used when every pooled string is already leased.
+    eastl::string mOverflow;
+};